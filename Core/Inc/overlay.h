@@ -0,0 +1,240 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+/*============================================================================
+ * OVERLAY IDS & WINDOW GEOMETRY
+ *============================================================================*/
+
+/*
+ * Overlay ids; index into the descriptor table. Overlay .ovl_<name> has
+ * id OVL_<NAME>, numbered by tools/ovlgen.py in linker script order.
+ * Plain integers, since the generated entry stubs (ovl_stubs.S) use
+ * them as immediates.
+ */
+#include "ovl_ids.h"
+
+#define OVL_NONE         0xFF
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Must match LENGTH(OVL) in the linker script */
+#define OVL_WINDOW_SIZE  3072U
+
+/* Residency granule; the window is tracked as OVL_SLOT_COUNT slots */
+#define OVL_SLOT_SIZE    256U
+#define OVL_SLOT_COUNT   (OVL_WINDOW_SIZE / OVL_SLOT_SIZE)
+
+typedef uint8_t ovl_id_t;
+
+/*
+ * One overlay, as recorded in the descriptor table by tools/ovlpack.py.
+ * Images are linked at load addresses that are never programmed; the
+ * packer stores each one behind the firmware, compressed when that
+ * saves space, and lma is where that copy ended up.
+ */
+typedef struct {
+    uint32_t id;                // OVL_<NAME>, also its index
+    uint32_t method;            // OVL_PACK_*
+    const uint8_t *lma;         // stored image
+    uint8_t *vma;               // run address inside the window
+    uint32_t size;              // image bytes
+    uint32_t packed_size;       // bytes at lma
+    uint32_t crc;               // of the unpacked image, see ovl_crc_image()
+    uint16_t entry_first;       // its global functions in the entry list
+    uint16_t entry_count;
+} ovl_desc_t;
+
+/*
+ * Descriptor table, placed behind the firmware with the images it
+ * describes. desc[] is indexed by id; the entry list (run addresses of
+ * every global function of each overlay, Thumb bit set) follows it.
+ */
+typedef struct {
+    uint32_t magic;             // OVL_TABLE_MAGIC
+    uint32_t count;             // descriptors
+    uint32_t entries;           // words in the entry list
+    ovl_desc_t desc[];
+} ovl_table_t;
+
+#define OVL_TABLE_MAGIC  0x544C564FU    // "OVLT"
+
+/* Storage methods */
+#define OVL_PACK_RAW     0U             // plain copy, DMA-able
+#define OVL_PACK_LZ4     1U             // LZ4 block format
+
+/* Defined by the linker script, filled in by tools/ovlpack.py */
+extern const ovl_table_t __ovl_table;
+
+/* Per-overlay counters */
+typedef struct {
+    uint32_t hits;              // acquires that found the overlay resident
+    uint32_t loads;             // times the image was copied in
+    uint32_t prefetches;        // loads that went through DMA
+    uint32_t evictions;         // times the overlay was pushed out
+    uint32_t crc_errors;        // loads or checks that failed the CRC
+} ovl_stats_t;
+
+
+/*============================================================================
+ * OVERLAY MANAGER
+ *============================================================================*/
+
+/*
+ * Reset the manager. table (normally &__ovl_table) must stay valid;
+ * window is the first byte of the OVL region. Nothing is resident after
+ * this call. A table with the wrong magic leaves every overlay
+ * unloadable.
+ */
+void ovl_init(const ovl_table_t *table, uint8_t *window);
+
+/*
+ * Make overlay id resident and pin it. The image is only copied when it
+ * is not already in the window; overlays occupying the slots it is
+ * linked for are evicted first. Returns the run address, or NULL if one
+ * of those occupants is still pinned.
+ *
+ * There is no replacement policy (LRU or otherwise) to apply: each
+ * overlay is linked for one fixed run address, so the residents that
+ * overlap its slots are the only possible victims, and they all have
+ * to go. Residents elsewhere in the window are never in the way.
+ */
+void *ovl_acquire(ovl_id_t id);
+
+/* Drop one pin taken by ovl_acquire(); the overlay stays resident */
+void ovl_release(ovl_id_t id);
+
+/* Non-zero if the image of id is currently in the window */
+int ovl_is_resident(ovl_id_t id);
+
+/*
+ * Check the resident copy of id against its link-time CRC. Returns
+ * non-zero if it is intact. A damaged copy is dropped, so the next
+ * acquire loads it again; zero is also returned if id is not resident.
+ * With OVL_VERIFY_HITS set to 1, every acquire that finds the overlay
+ * resident does this check first.
+ */
+int ovl_verify(ovl_id_t id);
+
+/*
+ * Start a DMA copy of id into its slots and return without waiting, so
+ * the load overlaps whatever the CPU does next. Returns non-zero if the
+ * overlay is resident or on its way; zero if the DMA channel is busy
+ * with another overlay or a pinned overlay holds the slots. Prefetching
+ * into one bank while the other bank executes gives ping-pong loading.
+ */
+int ovl_prefetch(ovl_id_t id);
+
+/* Block until a prefetch of id has landed; no-op otherwise */
+void ovl_wait(ovl_id_t id);
+
+/*
+ * Entry hook for the generated call stubs: make id resident without
+ * pinning it, then return so the stub can tail-call into the window.
+ * Calls ovl_port_fault() if the overlay cannot be loaded.
+ */
+void ovl_enter(ovl_id_t id);
+
+const ovl_stats_t *ovl_get_stats(ovl_id_t id);
+
+/*
+ * Scratch arena: lend the largest stretch of the window that no loaded
+ * or arriving overlay covers (the tail behind the resident overlays, or
+ * the whole window when none is) as workspace memory. Returns it 8-byte
+ * aligned with its size in *len, or NULL if it is shorter than min_len
+ * or already lent. Until ovl_scratch_release(), loads that would land on
+ * it fail as if a pinned overlay held the slots, so the borrower must
+ * not call into an overlay linked there.
+ */
+void *ovl_scratch_acquire(size_t min_len, size_t *len);
+void ovl_scratch_release(void);
+
+/* Bytes ovl_scratch_acquire() would lend right now */
+size_t ovl_scratch_avail(void);
+
+/* Descriptor of id, or NULL */
+const ovl_desc_t *ovl_get_desc(ovl_id_t id);
+
+/* Run address of the n-th global function of id, or NULL */
+void *ovl_entry(ovl_id_t id, unsigned n);
+
+
+/*============================================================================
+ * IMAGE STORE (ovl_store.c)
+ *============================================================================*/
+
+/*
+ * Unpack the image of d to d->vma and compute its CRC on the way.
+ * Returns 0, or -1 if the stored data is malformed or the CRC does not
+ * match the one recorded at link time.
+ */
+int ovl_image_load(const ovl_desc_t *d);
+
+/*
+ * Image CRC: the STM32 CRC unit in its reset configuration (polynomial
+ * 0x04C11DB7, initial value 0xFFFFFFFF, no reflection, no final XOR),
+ * fed one little-endian 32-bit word at a time. tools/ovlpack.py has the
+ * host model that produces the link-time values.
+ */
+uint32_t ovl_crc_image(const void *p, size_t len);
+
+/*
+ * Decode an LZ4 block into dst. Returns the number of bytes written, or
+ * -1 if src is malformed or would overrun dst. Runs from SRAM.
+ */
+int ovl_lz4_decode(uint8_t *dst, size_t dst_len, const uint8_t *src, size_t src_len);
+
+
+/*============================================================================
+ * PORT HOOKS (overlay_port.c on the board, tests/ovl_fake_port.c on the host)
+ *============================================================================*/
+
+/* DMA poll results */
+#define OVL_DMA_DONE     0
+#define OVL_DMA_BUSY     1
+#define OVL_DMA_ERROR    2
+
+/* Called once from ovl_init() */
+void ovl_port_init(void);
+
+/*
+ * Copy an overlay image from flash to its run address. Returns 0 if it
+ * arrived intact (CRC matches), -1 otherwise.
+ */
+int ovl_port_copy(const ovl_desc_t *d);
+
+/* 0 if the copy at d->vma still matches the image */
+int ovl_port_check(const ovl_desc_t *d);
+
+/*
+ * CRC unit hooks behind ovl_crc_image() and the checked raw copy:
+ * _begin resets the unit and returns its data register, _end reads the
+ * result once every word has been written there.
+ */
+volatile uint32_t *ovl_port_crc_begin(void);
+uint32_t ovl_port_crc_end(void);
+
+/*
+ * SRAM-resident word-burst routines behind the port (ovl_copy.S); dst
+ * and src word aligned, len a multiple of 4. The _crc variant and
+ * ovl_crc_words feed each word to crc_dr as well.
+ */
+void ovl_copy_words(void *dst, const void *src, size_t len);
+void ovl_copy_words_crc(void *dst, const void *src, size_t len,
+                        volatile uint32_t *crc_dr);
+void ovl_crc_words(const void *src, size_t len, volatile uint32_t *crc_dr);
+
+/* Start a memory-to-memory DMA copy of an image to its run address */
+void ovl_port_dma_start(const ovl_desc_t *d);
+
+/* Status of the transfer started last; a CRC mismatch is an error */
+int ovl_port_dma_poll(void);
+
+/* A stub called into an overlay that could not be loaded; never returns */
+void ovl_port_fault(ovl_id_t id);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* OVERLAY_H */
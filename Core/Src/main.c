@@ -9,30 +9,106 @@
 #include "tim.h"
 #include "usart.h"
 #include "gpio.h"
+#include "bearssl_hash.h"
 #include "bearssl_rsa.h"
 #include "mprime.h"
+#include "overlay.h"
 #include "vectors.h"
+#include "rsa_keys.h"
 
 /* Macros */
 #define OVERLAY_SIZE 3072U
 #define RSA_ITERS 10U
 #define RSA_SIZE 256U
+#define RSA_BATCH 2U   // signatures per br_rsa_i15_public_batch() call
 #define PRIME_ITERS 1000U
+#define MIX_ITERS 10U
+
+/* Overlay load methods timed at startup */
+#define LOAD_STORE 0   // ovl_port_copy(): unpack from the image store
+#define LOAD_BURST 1   // plain word-burst copy of the same length
+#define LOAD_MEMCPY 2  // newlib memcpy of the same length
+#define LOAD_CHECK 3   // ovl_port_check(): CRC of the resident copy
+#define LOAD_MODES 4
+
+/* Always-resident SRAM helpers timed at startup */
+#define RF_MEMCPY 0    // memcpy of RF_LEN bytes
+#define RF_CCOPY 1     // br_ccopy of RF_LEN bytes
+#define RF_LMUL 2      // RF_LMULS 64-bit multiplies (__aeabi_lmul)
+#define RF_HELPERS 3
+#define RF_LEN 256U
+#define RF_LMULS 16U
+
+/* SWAR primitives (BR_I15_SWAR) timed against the plain ones, on the
+   2048-bit test key */
+#define SW_CCOPY 0     // br_ccopy_swar vs br_ccopy, RF_LEN bytes
+#define SW_ZERO 1      // br_i15_zero_swar vs memset (plain br_i15_zero)
+#define SW_ADD 2       // br_i15_add_swar vs br_i15_add
+#define SW_SUB 3       // br_i15_sub_swar vs br_i15_sub
+#define SW_LOOKUP 4    // modpow_opt window lookup, SW_WINDOW entries
+#define SW_PRIMS 5
+#define SW_WINDOW 4U
+
+/* Montgomery squarings timed per method */
+#define SQR_ITERS 8U
+
+// PKCS#1 v1.5 and PSS verification of the rsakey.py --sign signatures
+#define VRFY_ITERS 4U
+#define VRFY_CHUNK 256U  // bytes per br_sha256_update(); multiple of 256
+
+/* Public-key engine of the generic RSA benchmarks, chosen by the
+   Makefile (RSA_ENGINE=i15 or i16); the pubctx, batch and squaring
+   reports are i15-only */
+#if RSA_ENGINE_I16
+#define rsa_public br_rsa_i16_public
+#define RSA_ENGINE_NAME "i16"
+#else
+#define rsa_public br_rsa_i15_public
+#define RSA_ENGINE_NAME "i15"
+#endif
 
 /* Externs */
 extern uint8_t __ovl_vma_start;
-extern uint8_t __ovl_rsa_lma_start;
-extern uint8_t __ovl_rsa_lma_end;
-extern uint8_t __ovl_prime_lma_start;
-extern uint8_t __ovl_prime_lma_end;
+extern uint8_t _sramfunc, _eramfunc, _siramfunc, __ramfunc_budget;
+extern void br_ccopy(uint32_t ctl, void *dst, const void *src, size_t len);
+extern long long __aeabi_lmul(long long a, long long b);
+extern void br_ccopy_swar(uint32_t ctl, void *dst, const void *src, size_t len);
+extern void br_i15_zero_swar(uint16_t *x, uint16_t bit_len);
+extern uint32_t br_i15_add(uint16_t *a, const uint16_t *b, uint32_t ctl);
+extern uint32_t br_i15_add_swar(uint16_t *a, const uint16_t *b, uint32_t ctl);
+extern uint32_t br_i15_sub(uint16_t *a, const uint16_t *b, uint32_t ctl);
+extern uint32_t br_i15_sub_swar(uint16_t *a, const uint16_t *b, uint32_t ctl);
+extern void br_i15_lookup_swar(uint16_t *d, const uint16_t *tab, size_t mwlen,
+                               uint32_t num, uint32_t idx);
+extern void br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+                            const uint16_t *m, uint16_t m0i);
+extern void br_i15_montysqr(uint16_t *d, const uint16_t *x,
+                            const uint16_t *m, uint16_t m0i);
+extern void br_i16_decode(uint16_t *x, const void *src, size_t len);
+extern uint32_t br_i16_decode_mod(uint16_t *x, const void *src, size_t len,
+                                  const uint16_t *m);
+extern uint16_t br_i16_ninv16(uint16_t x);
+extern void br_i16_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+                            const uint16_t *m, uint16_t m0i);
 
 /* Function Prototypes */
 void SystemClock_Config(void);
 int _write(int fd, const char* buf, int size);
-static void overlay_load_rsa(void);
-static void overlay_load_prime(void);
-static uint32_t rsa_bench(size_t iters);
+static uint32_t rsa_bench(size_t iters, const br_rsa_i15_pubctx *ctx);
+#if !RSA_ENGINE_I16
+static uint32_t rsa_batch_bench(size_t iters, const br_rsa_i15_pubctx *ctx);
+#endif
 static uint32_t prime_bench(size_t iters);
+static uint32_t mix_bench(size_t iters);
+static void ovl_report(const char *name, ovl_id_t id);
+static uint32_t load_cycles(ovl_id_t id, int how);
+static void ovl_banner(const char *name, ovl_id_t id, const uint32_t *load);
+static void ramfunc_report(void);
+static void swar_report(void);
+static void sqr_report(void);
+#if !RSA_ENGINE_I16
+static void vrfy_report(void);
+#endif
 int main(void)
 {
   // System init
@@ -43,31 +119,67 @@ int main(void)
   MX_USART2_UART_Init();
   MX_TIM2_Init();
 
+  ovl_init(&__ovl_table, &__ovl_vma_start);
+
+  //time a CPU load of each image while the window is still unused
+  uint32_t load[OVL_COUNT][LOAD_MODES];
+  for (ovl_id_t id = 0; id < OVL_COUNT; id++) {
+    for (int how = 0; how < LOAD_MODES; how++) {
+      load[id][how] = load_cycles(id, how);
+    }
+  }
+
   printf("\r\nSystem Init @ %lu Hz\r\n", SystemCoreClock);
+  ramfunc_report();
+  swar_report();
 
-  //Load RSA overlay
-  overlay_load_rsa();
-  printf("RSA Overlay: %lu bytes @ %p -> %p\r\n",
-               (unsigned long)(&__ovl_rsa_lma_end - &__ovl_rsa_lma_start),
-               &__ovl_rsa_lma_start,
-               &__ovl_vma_start);
+  //start loading RSA while the banner goes out; the entry stub of the
+  //first call waits for it to land
+  ovl_prefetch(OVL_RSA);
+  ovl_banner("RSA", OVL_RSA, load[OVL_RSA]);
+  printf("Scratch: %lu bytes of the window free for RSA temporaries\r\n",
+         (unsigned long)ovl_scratch_avail());
 
   uint8_t tmp[RSA_SIZE];
   memcpy(tmp, M0_be, RSA_SIZE);
-  (void)br_rsa_i15_public(tmp, RSA_SIZE, &pk);
+  (void)rsa_public(tmp, RSA_SIZE, &pk);
 
-  uint32_t t_rsa = rsa_bench(RSA_ITERS);
+  uint32_t t_rsa = rsa_bench(RSA_ITERS, NULL);
   uint32_t us_per_rsa = (t_rsa + RSA_ITERS/2) / RSA_ITERS;
 
-  printf("RSA2048 (overlay): iters=%lu total_us=%lu, us/op=%lu\r\n",
+  printf("RSA2048 (overlay, " RSA_ENGINE_NAME "): iters=%lu total_us=%lu, us/op=%lu\r\n",
          (unsigned long)RSA_ITERS, (unsigned long)t_rsa, (unsigned long)us_per_rsa);
 
-  //load prime overlay
-  overlay_load_prime();
-  printf("Prime Overlay: %lu bytes @ %p -> %p\r\n",
-               (unsigned long)(&__ovl_prime_lma_end - &__ovl_prime_lma_start),
-               &__ovl_prime_lma_start,
-               &__ovl_vma_start);
+#if !RSA_ENGINE_I16
+
+  //same key through the context compiled from data/rsa_priv.pem
+  //(modulus, m0i, R^2 mod N in flash; no setup at all)
+  uint32_t t_ctx = rsa_bench(RSA_ITERS, &test_key_pub);
+  printf("RSA2048 (pubctx): iters=%lu total_us=%lu, us/op=%lu\r\n",
+         (unsigned long)RSA_ITERS, (unsigned long)t_ctx,
+         (unsigned long)((t_ctx + RSA_ITERS/2) / RSA_ITERS));
+
+  //and in bursts: one overlay entry and one workspace per RSA_BATCH
+  uint32_t t_batch = rsa_batch_bench(RSA_ITERS, &test_key_pub);
+  printf("RSA2048 (batch of %u): iters=%lu total_us=%lu, us/op=%lu\r\n",
+         RSA_BATCH, (unsigned long)RSA_ITERS, (unsigned long)t_batch,
+         (unsigned long)((t_batch + RSA_ITERS/2) / RSA_ITERS));
+
+  //what a caller-owned workspace needs for this key
+  printf("RSA workspace: %lu bytes (br_rsa_i15_public_ws)\r\n",
+         (unsigned long)br_rsa_i15_public_ws_len(&pk));
+#endif
+
+  //the DMA channel is free once RSA has landed: prime streams into
+  //bank 1 while the squarings run from bank 0
+  ovl_wait(OVL_RSA);
+  if (!ovl_prefetch(OVL_PRIME)) {
+    printf("Prime prefetch refused, loading on first call\r\n");
+  }
+  sqr_report();
+
+  //prime overlay
+  ovl_banner("Prime", OVL_PRIME, load[OVL_PRIME]);
 
   uint32_t t_prime = prime_bench(PRIME_ITERS);
   uint32_t us_per_prime = (t_prime + PRIME_ITERS/2) / PRIME_ITERS;
@@ -77,6 +189,22 @@ int main(void)
          (unsigned long)t_prime,
          (unsigned long)us_per_prime);
 
+  //alternate RSA and prime; both stay resident in their own banks
+  uint32_t t_mix = mix_bench(MIX_ITERS);
+  printf("RSA+mPrime (interleaved): iters=%lu total_us=%lu, us/iter=%lu\r\n",
+         (unsigned long)MIX_ITERS,
+         (unsigned long)t_mix,
+         (unsigned long)((t_mix + MIX_ITERS/2) / MIX_ITERS));
+
+#if !RSA_ENGINE_I16
+  //whole signature checks: hash in bank 1 next to RSA in bank 0
+  ovl_banner("SHA-256", OVL_SHA, load[OVL_SHA]);
+  vrfy_report();
+#endif
+  ovl_report("rsa", OVL_RSA);
+  ovl_report("prime", OVL_PRIME);
+  ovl_report("sha", OVL_SHA);
+
   while (1)
   {
   }
@@ -135,24 +263,262 @@ int _write(int fd, const char *buf, int size) {
   return size;
 }
 
-//overlay loader
-static void overlay_load(const uint8_t* lma_start, const uint8_t* lma_end) {
-  size_t size = lma_end - lma_start;
-  memcpy(&__ovl_vma_start, lma_start, size);
+//overlay manager counters
+static void ovl_report(const char *name, ovl_id_t id) {
+  const ovl_stats_t *st = ovl_get_stats(id);
+  printf("ovl %s: loads=%lu (dma %lu) hits=%lu evictions=%lu crc_errors=%lu\r\n",
+         name, (unsigned long)st->loads, (unsigned long)st->prefetches,
+         (unsigned long)st->hits, (unsigned long)st->evictions,
+         (unsigned long)st->crc_errors);
 }
 
-//rsa overlay load
-static void overlay_load_rsa(void) {
-  overlay_load(&__ovl_rsa_lma_start, &__ovl_rsa_lma_end);
+//cycles for one CPU load of an overlay image (LOAD_*); the plain copies
+//read the same number of bytes from the start of flash. SysTick wraps
+//every 1 ms, far longer than a 3 KB load
+static uint32_t load_cycles(ovl_id_t id, int how) {
+  const ovl_desc_t *d = ovl_get_desc(id);
+  const void *flash = (const void *)FLASH_BASE;
+  uint32_t period = SysTick->LOAD + 1u;
+
+  if (d == NULL) {
+    return 0;
+  }
+  size_t len = d->size;
+
+  uint32_t t0 = SysTick->VAL;
+  if (how == LOAD_STORE) {
+    ovl_port_copy(d);
+  } else if (how == LOAD_BURST) {
+    ovl_copy_words(d->vma, flash, len);
+  } else if (how == LOAD_MEMCPY) {
+    memcpy(d->vma, flash, len);
+  } else {
+    (void)ovl_port_check(d);
+  }
+  uint32_t t1 = SysTick->VAL;
+
+  return (t0 - t1 + period) % period;
 }
 
-//prime overlay load
-static void overlay_load_prime(void) {
-  overlay_load(&__ovl_prime_lma_start, &__ovl_prime_lma_end);
+//size, storage and load cost of an overlay
+static void ovl_banner(const char *name, ovl_id_t id, const uint32_t *load) {
+  const ovl_desc_t *d = ovl_get_desc(id);
+
+  if (d == NULL) {
+    printf("%s Overlay: not in the descriptor table\r\n", name);
+    return;
+  }
+  printf("%s Overlay: %lu bytes (%s %lu) @ %p -> %p, %u entries, load %lu cycles"
+         " (copy %lu, memcpy %lu), verify %lu\r\n", name,
+         (unsigned long)d->size,
+         d->method == OVL_PACK_LZ4 ? "lz4" : "raw",
+         (unsigned long)d->packed_size,
+         d->lma,
+         d->vma,
+         (unsigned)d->entry_count,
+         (unsigned long)load[LOAD_STORE],
+         (unsigned long)load[LOAD_BURST],
+         (unsigned long)load[LOAD_MEMCPY],
+         (unsigned long)load[LOAD_CHECK]);
+}
+
+//flash copy of a .ramfunc function: the image Reset_Handler copied it
+//from. Only valid for leaf functions, whose branches stay inside it
+static const void *ramfunc_flash(const void *fn) {
+  uintptr_t a = (uintptr_t)fn;
+
+  if (a < (uintptr_t)&_sramfunc || a >= (uintptr_t)&_eramfunc) {
+    return NULL;
+  }
+  return (const void *)(a - (uintptr_t)&_sramfunc + (uintptr_t)&_siramfunc);
+}
+
+//cycles for one RF_* workload run through fn; buf holds 2 * RF_LEN bytes
+static uint32_t ramfunc_cycles(const void *fn, int which, uint8_t *buf) {
+  uint32_t period = SysTick->LOAD + 1u;
+  volatile long long sink = 0x243F6A8885A308D3LL;
+  uintptr_t f = (uintptr_t)fn;
+
+  uint32_t t0 = SysTick->VAL;
+  if (which == RF_MEMCPY) {
+    ((void *(*)(void *, const void *, size_t))f)(buf, buf + RF_LEN, RF_LEN);
+  } else if (which == RF_CCOPY) {
+    ((void (*)(uint32_t, void *, const void *, size_t))f)(1, buf, buf + RF_LEN, RF_LEN);
+  } else {
+    for (uint32_t i = 0; i < RF_LMULS; i++) {
+      sink = ((long long (*)(long long, long long))f)(sink, 0x13198A2E03707344LL);
+    }
+  }
+  uint32_t t1 = SysTick->VAL;
+
+  return (t0 - t1 + period) % period;
+}
+
+//size of .ramfunc and what running each helper from it saves over its
+//flash copy; borrows the overlay window for buffers while it is idle
+static void ramfunc_report(void) {
+  static const char *const name[RF_HELPERS] = { "memcpy", "br_ccopy", "lmul" };
+  const void *fn[RF_HELPERS] = {
+    (const void *)memcpy, (const void *)br_ccopy, (const void *)__aeabi_lmul,
+  };
+  size_t len;
+  uint8_t *buf = ovl_scratch_acquire(2 * RF_LEN, &len);
+
+  printf("RamFunc: %lu/%lu bytes\r\n",
+         (unsigned long)(&_eramfunc - &_sramfunc),
+         (unsigned long)(uintptr_t)&__ramfunc_budget);
+  if (buf == NULL) {
+    return;
+  }
+  for (int i = 0; i < RF_HELPERS; i++) {
+    const void *flash = ramfunc_flash(fn[i]);
+    if (flash == NULL) {
+      printf("  %-8s not in .ramfunc\r\n", name[i]);
+      continue;
+    }
+    uint32_t sram = ramfunc_cycles(fn[i], i, buf);
+    uint32_t rom = ramfunc_cycles(flash, i, buf);
+    printf("  %-8s %lu cycles (flash %lu, saves %ld)\r\n", name[i],
+           (unsigned long)sram, (unsigned long)rom, (long)rom - (long)sram);
+  }
+  ovl_scratch_release();
+}
+
+//window lookup as br_i15_modpow_opt() does it without BR_I15_SWAR: one
+//word of every entry at a time
+static void lookup_plain(uint16_t *d, const uint16_t *tab, size_t mwlen,
+                         uint32_t num, uint32_t idx) {
+  for (size_t v = 1; v < mwlen; v++) {
+    d[v] = 0;
+  }
+  for (uint32_t u = 1; u < num; u++) {
+    uint16_t mask = (uint16_t)-(uint32_t)(u == idx);
+    for (size_t v = 1; v < mwlen; v++) {
+      d[v] |= mask & tab[v];
+    }
+    tab += mwlen;
+  }
+}
+
+//cycles for one SW_* workload, SWAR or plain; a, b, d and the table
+//are refilled from the test key first so both see the same inputs
+static uint32_t swar_cycles(int which, int swar, uint16_t *buf) {
+  const br_rsa_i15_pubctx *k = &test_key_pub;
+  const size_t w = BR_RSA_I15_PUBCTX_WORDS;
+  uint32_t period = SysTick->LOAD + 1u;
+  //value words of each integer on a 32-bit boundary, as BearSSL lays out
+  uint16_t *a = buf + 1, *b = a + w, *d = b + w, *tab = d + w;
+
+  memcpy(a, k->r2, w * sizeof *a);
+  memcpy(b, k->m, w * sizeof *b);
+  for (uint32_t u = 1; u < SW_WINDOW; u++) {
+    memcpy(tab + (u - 1) * w, k->r2, w * sizeof *tab);
+  }
+
+  uint32_t t0 = SysTick->VAL;
+  switch (which) {
+  case SW_CCOPY:
+    (swar ? br_ccopy_swar : br_ccopy)(1, a, b, RF_LEN);
+    break;
+  case SW_ZERO:
+    if (swar) {
+      br_i15_zero_swar(a, k->m[0]);
+    } else {
+      a[0] = k->m[0];
+      memset(a + 1, 0, ((k->m[0] + 15) >> 4) * sizeof *a);
+    }
+    break;
+  case SW_ADD:
+    (void)(swar ? br_i15_add_swar : br_i15_add)(a, b, 1);
+    break;
+  case SW_SUB:
+    (void)(swar ? br_i15_sub_swar : br_i15_sub)(a, b, 1);
+    break;
+  default:
+    (swar ? br_i15_lookup_swar : lookup_plain)(d, tab, w, SW_WINDOW,
+                                               SW_WINDOW - 1);
+    break;
+  }
+  uint32_t t1 = SysTick->VAL;
+
+  return (t0 - t1 + period) % period;
+}
+
+//each SWAR primitive (in .ramfunc) next to the version it replaces;
+//borrows the overlay window for buffers while it is idle
+static void swar_report(void) {
+  static const char *const name[SW_PRIMS] = {
+    "ccopy", "zero", "add", "sub", "lookup",
+  };
+  size_t len;
+  uint16_t *buf = ovl_scratch_acquire(
+      (1 + (2 + SW_WINDOW) * BR_RSA_I15_PUBCTX_WORDS) * sizeof(uint16_t), &len);
+
+  if (buf == NULL) {
+    return;
+  }
+  printf("SWAR:\r\n");
+  for (int i = 0; i < SW_PRIMS; i++) {
+    uint32_t swar = swar_cycles(i, 1, buf);
+    uint32_t plain = swar_cycles(i, 0, buf);
+    printf("  %-8s %lu cycles (plain %lu)\r\n", name[i],
+           (unsigned long)swar, (unsigned long)plain);
+  }
+  ovl_scratch_release();
+}
+
+#if RSA_ENGINE_I16
+//cycles per 2048-bit i16 Montgomery product x*x, to set against the
+//montymul figure of an i15 build; the key is decoded at runtime since
+//the compiled tables are i15
+static void sqr_report(void) {
+  uint16_t m[2 + RSA_SIZE / 2], x[2 + RSA_SIZE / 2], d[2 + RSA_SIZE / 2];
+  uint32_t mhz = SystemCoreClock / 1000000u;
+
+  br_i16_decode(m, pk.n, pk.nlen);
+  uint16_t m0i = br_i16_ninv16(m[1]);
+  (void)br_i16_decode_mod(x, M0_be, RSA_SIZE, m);
+
+  LL_TIM_SetCounter(TIM2, 0);
+  LL_TIM_EnableCounter(TIM2);
+  for (uint32_t i = 0; i < SQR_ITERS; i++) {
+    br_i16_montymul(d, x, x, m, m0i);
+  }
+  uint32_t t_mul = LL_TIM_GetCounter(TIM2);
+
+  printf("Squaring: i16 montymul x*x %lu cycles\r\n",
+         (unsigned long)(t_mul * mhz / SQR_ITERS));
+}
+#else
+//cycles per 2048-bit Montgomery squaring, as a generic product and with
+//br_i15_montysqr(); several squarings per TIM2 (us) reading, since one
+//takes longer than a SysTick period
+static void sqr_report(void) {
+  const br_rsa_i15_pubctx *k = &test_key_pub;
+  uint16_t d[BR_RSA_I15_PUBCTX_WORDS];
+  uint32_t mhz = SystemCoreClock / 1000000u;
+
+  LL_TIM_SetCounter(TIM2, 0);
+  LL_TIM_EnableCounter(TIM2);
+  for (uint32_t i = 0; i < SQR_ITERS; i++) {
+    br_i15_montymul(d, k->r2, k->r2, k->m, k->m0i);
+  }
+  uint32_t t_mul = LL_TIM_GetCounter(TIM2);
+
+  LL_TIM_SetCounter(TIM2, 0);
+  for (uint32_t i = 0; i < SQR_ITERS; i++) {
+    br_i15_montysqr(d, k->r2, k->m, k->m0i);
+  }
+  uint32_t t_sqr = LL_TIM_GetCounter(TIM2);
+
+  printf("Squaring: %lu cycles (montymul x*x %lu)\r\n",
+         (unsigned long)(t_sqr * mhz / SQR_ITERS),
+         (unsigned long)(t_mul * mhz / SQR_ITERS));
 }
+#endif
 
-// rsa benchmark
-static uint32_t rsa_bench(size_t iters) {
+// rsa benchmark; through the precomputed key when ctx is not NULL
+static uint32_t rsa_bench(size_t iters, const br_rsa_i15_pubctx *ctx) {
   uint8_t work[RSA_SIZE];
 
   LL_TIM_SetCounter(TIM2, 0);
@@ -163,13 +529,127 @@ static uint32_t rsa_bench(size_t iters) {
     work[127] ^= (uint8_t)i;  // vary input but keep < N
 
     
-    uint32_t ok = br_rsa_i15_public(work, sizeof work, &pk);
+#if RSA_ENGINE_I16
+    (void)ctx;
+    uint32_t ok = rsa_public(work, sizeof work, &pk);
+#else
+    uint32_t ok = ctx != NULL ? br_rsa_i15_public_ctx(work, sizeof work, ctx)
+                              : rsa_public(work, sizeof work, &pk);
+#endif
     __asm__ volatile("" :: "r"(ok), "r"(work[127]) : "memory");
   }
 
   return LL_TIM_GetCounter(TIM2);  // us
 }
 
+#if !RSA_ENGINE_I16
+// rsa benchmark, RSA_BATCH same-key signatures per call; iters is
+// rounded down to whole batches
+static uint32_t rsa_batch_bench(size_t iters, const br_rsa_i15_pubctx *ctx) {
+  uint8_t work[RSA_BATCH][RSA_SIZE];
+  uint8_t *sigs[RSA_BATCH];
+  uint32_t ok[RSA_BATCH];
+  size_t good = 0;
+
+  LL_TIM_SetCounter(TIM2, 0);
+  LL_TIM_EnableCounter(TIM2);
+
+  for (size_t i = 0; i + RSA_BATCH <= iters; i += RSA_BATCH) {
+    for (size_t j = 0; j < RSA_BATCH; j++) {
+      memcpy(work[j], M0_be, RSA_SIZE);
+      work[j][127] ^= (uint8_t)(i + j);  // vary input but keep < N
+      sigs[j] = work[j];
+    }
+    good += br_rsa_i15_public_batch(ctx, sigs, RSA_BATCH, ok);
+    __asm__ volatile("" :: "r"(good), "r"(ok) : "memory");
+  }
+
+  return LL_TIM_GetCounter(TIM2);  // us
+}
+#endif
+
+#if !RSA_ENGINE_I16
+// end-to-end signature verification: SHA-256 over the first
+// s->msg_len bytes of the pattern message, fed VRFY_CHUNK bytes at a
+// time from chunk[], then the PKCS#1 v1.5 or (pss) the PSS check with
+// pk (the public half of data/rsa_priv.pem); counts the signatures
+// that verify into *good
+static uint32_t vrfy_bench(const rsakey_sig *s, size_t iters,
+                           const uint8_t *chunk, int pss, uint32_t *good) {
+  br_sha256_context sc;
+  uint8_t hash[br_sha256_SIZE];
+  uint8_t signed_hash[br_sha256_SIZE];
+
+  *good = 0;
+  LL_TIM_SetCounter(TIM2, 0);
+  LL_TIM_EnableCounter(TIM2);
+
+  for (size_t i = 0; i < iters; i++) {
+    br_sha256_init(&sc);
+    for (uint32_t n = 0; n < s->msg_len; n += VRFY_CHUNK) {
+      uint32_t len = s->msg_len - n;
+      br_sha256_update(&sc, chunk, len < VRFY_CHUNK ? len : VRFY_CHUNK);
+    }
+    br_sha256_out(&sc, hash);
+    if (pss) {
+      //MGF1 over the 223 bytes of DB and the H' check: nine more
+      //SHA-256 blocks, through the vtable into the resident bank 1
+      if (br_rsa_i15_pss_vrfy(s->pss, s->pss_len, &br_sha256_vtable,
+                              &br_sha256_vtable, hash, s->salt_len, &pk)) {
+        (*good)++;
+      }
+    } else if (br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, BR_HASH_OID_SHA256,
+                                     sizeof hash, &pk, signed_hash)
+               && memcmp(hash, signed_hash, sizeof hash) == 0) {
+      (*good)++;
+    }
+  }
+
+  return LL_TIM_GetCounter(TIM2);  // us
+}
+
+// one line of vrfy_report(); t is the total for VRFY_ITERS
+static void vrfy_line(const char *name, uint32_t msg_len, uint32_t t,
+                      uint32_t good) {
+  if (t == 0) {
+    t = 1;
+  }
+  uint64_t per_s = (uint64_t)VRFY_ITERS * 1000000U;
+  uint32_t vps100 = (uint32_t)(per_s * 100U / t);
+  printf("%-6s %5lu B: iters=%lu us/op=%lu verifies/s=%lu.%02lu"
+         " bytes/s=%lu ok=%lu\r\n",
+         name, (unsigned long)msg_len, (unsigned long)VRFY_ITERS,
+         (unsigned long)((t + VRFY_ITERS/2) / VRFY_ITERS),
+         (unsigned long)(vps100 / 100U), (unsigned long)(vps100 % 100U),
+         (unsigned long)(per_s * msg_len / t), (unsigned long)good);
+}
+
+// verification throughput for every signed message length, PKCS#1
+// v1.5 and then PSS on the same message; the last line is what PSS
+// adds per verification
+static void vrfy_report(void) {
+  uint8_t chunk[VRFY_CHUNK];
+  uint32_t t_pkcs1 = 0, t_pss = 0;
+
+  //the pattern message: byte i is i & 0xFF
+  for (size_t i = 0; i < sizeof chunk; i++) {
+    chunk[i] = (uint8_t)i;
+  }
+  ovl_prefetch(OVL_SHA);
+  for (size_t k = 0; k < sizeof test_key_sig / sizeof test_key_sig[0]; k++) {
+    const rsakey_sig *s = &test_key_sig[k];
+    uint32_t good;
+
+    t_pkcs1 = vrfy_bench(s, VRFY_ITERS, chunk, 0, &good);
+    vrfy_line("Verify", s->msg_len, t_pkcs1, good);
+    t_pss = vrfy_bench(s, VRFY_ITERS, chunk, 1, &good);
+    vrfy_line("PSS", s->msg_len, t_pss, good);
+  }
+  printf("PSS vs PKCS#1: %+ld us/op\r\n",
+         ((long)t_pss - (long)t_pkcs1 + (long)VRFY_ITERS/2) / (long)VRFY_ITERS);
+}
+#endif
+
 // mprime benchmark
 static uint32_t prime_bench(size_t iters) {
   LL_TIM_SetCounter(TIM2, 0);
@@ -185,4 +665,28 @@ static uint32_t prime_bench(size_t iters) {
   __asm__ volatile ("" :: "r"(acc) : "memory");
 
   return LL_TIM_GetCounter(TIM2);
-}
\ No newline at end of file
+}
+
+// interleaved rsa/mprime benchmark; each phase prefetches the other bank
+static uint32_t mix_bench(size_t iters) {
+  uint8_t work[RSA_SIZE];
+  volatile int acc = 0;
+
+  LL_TIM_SetCounter(TIM2, 0);
+  LL_TIM_EnableCounter(TIM2);
+
+  for (size_t i = 0; i < iters; i++) {
+    memcpy(work, M0_be, sizeof work);
+    work[127] ^= (uint8_t)i;
+
+    ovl_prefetch(OVL_PRIME);
+    acc += (int)rsa_public(work, sizeof work, &pk);
+
+    ovl_prefetch(OVL_RSA);
+    acc += ll_test_M127();
+  }
+
+  __asm__ volatile ("" :: "r"(acc) : "memory");
+
+  return LL_TIM_GetCounter(TIM2);
+}
@@ -0,0 +1,349 @@
+#include "overlay.h"
+
+// Check the CRC of a resident overlay on every acquire that hits
+#ifndef OVL_VERIFY_HITS
+#define OVL_VERIFY_HITS  0
+#endif
+
+/*============================================================================
+ * MANAGER STATE
+ *============================================================================*/
+
+static const ovl_table_t *ovl_table;
+static ovl_id_t ovl_count;                  // usable descriptors
+static uint8_t *ovl_window;
+
+static uint8_t slot_owner[OVL_SLOT_COUNT];  // OVL_NONE when free
+static uint8_t ovl_first[OVL_COUNT];        // slots covered: [first, end)
+static uint8_t ovl_end[OVL_COUNT];
+static uint8_t ovl_resident[OVL_COUNT];
+static uint8_t ovl_pins[OVL_COUNT];
+static ovl_id_t ovl_inflight = OVL_NONE;    // target of the running DMA load
+static ovl_stats_t ovl_stats[OVL_COUNT];
+static size_t scratch_lo, scratch_hi;       // lent window bytes; empty if equal
+
+/*============================================================================
+ * SLOT BOOKKEEPING (STATIC)
+ *============================================================================*/
+
+static const ovl_desc_t *ovl_desc(ovl_id_t id)
+{
+    return &ovl_table->desc[id];
+}
+
+static size_t ovl_offset(ovl_id_t id)
+{
+    return (size_t)(ovl_desc(id)->vma - ovl_window);
+}
+
+static int ovl_occupies(ovl_id_t id)
+{
+    return ovl_resident[id] || ovl_inflight == id;
+}
+
+static void ovl_unclaim(ovl_id_t id)
+{
+    for (unsigned s = ovl_first[id]; s < ovl_end[id]; s++) {
+        if (slot_owner[s] == id) {
+            slot_owner[s] = OVL_NONE;
+        }
+    }
+    ovl_resident[id] = 0;
+}
+
+static void ovl_evict(ovl_id_t id)
+{
+    ovl_unclaim(id);
+    ovl_stats[id].evictions++;
+}
+
+/* CPU load into slots already cleared; 0 on success */
+static int ovl_copy_in(ovl_id_t id)
+{
+    if (ovl_port_copy(ovl_desc(id)) != 0) {
+        ovl_stats[id].crc_errors++;
+        return -1;
+    }
+    return 0;
+}
+
+static void ovl_claim(ovl_id_t id)
+{
+    for (unsigned s = ovl_first[id]; s < ovl_end[id]; s++) {
+        slot_owner[s] = id;
+    }
+    ovl_stats[id].loads++;
+}
+
+/*
+ * Retire the outstanding DMA load once the port reports it finished.
+ * With block set, spin until it does. A failed transfer (bus error or
+ * CRC mismatch) is redone with a CPU copy so the overlay is never
+ * marked resident half-loaded; if that fails too, its slots are freed.
+ */
+static void ovl_dma_finish(int block)
+{
+    ovl_id_t id = ovl_inflight;
+    int st;
+
+    if (id == OVL_NONE) {
+        return;
+    }
+    do {
+        st = ovl_port_dma_poll();
+    } while (block && st == OVL_DMA_BUSY);
+    if (st == OVL_DMA_BUSY) {
+        return;
+    }
+
+    ovl_inflight = OVL_NONE;
+    if (st == OVL_DMA_ERROR) {
+        ovl_stats[id].crc_errors++;
+        if (ovl_copy_in(id) != 0) {
+            ovl_unclaim(id);
+            return;
+        }
+    }
+    ovl_resident[id] = 1;
+}
+
+/*
+ * Evict whatever sits in the slots id is linked for. Fails without
+ * touching anything if one of the occupants is pinned; an occupant
+ * still arriving by DMA is waited for first.
+ */
+static int ovl_make_room(ovl_id_t id)
+{
+    size_t off = ovl_offset(id);
+
+    if (off < scratch_hi && scratch_lo < off + ovl_desc(id)->size) {
+        return 0;
+    }
+    for (unsigned s = ovl_first[id]; s < ovl_end[id]; s++) {
+        uint8_t owner = slot_owner[s];
+        if (owner != OVL_NONE && ovl_pins[owner] != 0) {
+            return 0;
+        }
+    }
+    if (ovl_inflight != OVL_NONE && ovl_inflight != id) {
+        for (unsigned s = ovl_first[id]; s < ovl_end[id]; s++) {
+            if (slot_owner[s] == ovl_inflight) {
+                ovl_dma_finish(1);
+                break;
+            }
+        }
+    }
+    for (unsigned s = ovl_first[id]; s < ovl_end[id]; s++) {
+        if (slot_owner[s] != OVL_NONE) {
+            ovl_evict(slot_owner[s]);
+        }
+    }
+    return 1;
+}
+
+/*
+ * Largest stretch of the window outside every overlay that is loaded or
+ * arriving, as [*lo, *lo + return). Candidates start at the window base
+ * or right behind an occupant; on a tie the higher one wins.
+ */
+static size_t ovl_scratch_gap(size_t *lo)
+{
+    size_t best = 0;
+
+    *lo = OVL_WINDOW_SIZE;
+    for (int c = -1; c < (int)ovl_count; c++) {
+        size_t start = 0;
+        size_t end = OVL_WINDOW_SIZE;
+
+        if (c >= 0) {
+            if (!ovl_occupies((ovl_id_t)c)) {
+                continue;
+            }
+            start = (ovl_offset((ovl_id_t)c) + ovl_desc((ovl_id_t)c)->size + 7u) & ~(size_t)7u;
+        }
+        for (ovl_id_t id = 0; id < ovl_count && start < end; id++) {
+            size_t off = ovl_offset(id);
+            if (!ovl_occupies(id)) {
+                continue;
+            }
+            if (off <= start && start < off + ovl_desc(id)->size) {
+                start = end;            // starts inside an occupant
+            } else if (off > start && off < end) {
+                end = off;
+            }
+        }
+        if (start < end && (end - start > best || (end - start == best && start > *lo))) {
+            best = end - start;
+            *lo = start;
+        }
+    }
+    return best;
+}
+
+/*============================================================================
+ * PUBLIC API
+ *============================================================================*/
+
+void ovl_init(const ovl_table_t *table, uint8_t *window)
+{
+    ovl_table = table;
+    ovl_count = 0;
+    if (table->magic == OVL_TABLE_MAGIC) {
+        ovl_count = table->count < OVL_COUNT ? (ovl_id_t)table->count : OVL_COUNT;
+    }
+    ovl_window = window;
+    ovl_inflight = OVL_NONE;
+    scratch_lo = scratch_hi = 0;
+    ovl_port_init();
+
+    for (unsigned s = 0; s < OVL_SLOT_COUNT; s++) {
+        slot_owner[s] = OVL_NONE;
+    }
+
+    for (ovl_id_t id = 0; id < ovl_count; id++) {
+        size_t off = (size_t)(table->desc[id].vma - window);
+        ovl_first[id] = (uint8_t)(off / OVL_SLOT_SIZE);
+        ovl_end[id] = (uint8_t)((off + table->desc[id].size + OVL_SLOT_SIZE - 1u)
+                                / OVL_SLOT_SIZE);
+        ovl_resident[id] = 0;
+        ovl_pins[id] = 0;
+        ovl_stats[id] = (ovl_stats_t){ 0 };
+    }
+}
+
+void *ovl_acquire(ovl_id_t id)
+{
+    if (id >= ovl_count) {
+        return NULL;
+    }
+
+    ovl_dma_finish(ovl_inflight == id);
+    if (ovl_resident[id] && (!OVL_VERIFY_HITS || ovl_verify(id))) {
+        ovl_stats[id].hits++;
+    } else {
+        if (!ovl_make_room(id) || ovl_copy_in(id) != 0) {
+            return NULL;
+        }
+        ovl_claim(id);
+        ovl_resident[id] = 1;
+    }
+
+    ovl_pins[id]++;
+    return ovl_desc(id)->vma;
+}
+
+void ovl_release(ovl_id_t id)
+{
+    if (id < ovl_count && ovl_pins[id] != 0) {
+        ovl_pins[id]--;
+    }
+}
+
+int ovl_is_resident(ovl_id_t id)
+{
+    ovl_dma_finish(0);
+    return id < ovl_count && ovl_resident[id];
+}
+
+int ovl_verify(ovl_id_t id)
+{
+    if (!ovl_is_resident(id)) {
+        return 0;
+    }
+    if (ovl_port_check(ovl_desc(id)) != 0) {
+        ovl_stats[id].crc_errors++;
+        ovl_unclaim(id);
+        return 0;
+    }
+    return 1;
+}
+
+int ovl_prefetch(ovl_id_t id)
+{
+    if (id >= ovl_count) {
+        return 0;
+    }
+
+    ovl_dma_finish(0);
+    if (ovl_resident[id] || ovl_inflight == id) {
+        return 1;
+    }
+    if (ovl_inflight != OVL_NONE || !ovl_make_room(id)) {
+        return 0;
+    }
+
+    ovl_claim(id);
+    ovl_stats[id].prefetches++;
+    ovl_inflight = id;
+    ovl_port_dma_start(ovl_desc(id));
+    return 1;
+}
+
+void ovl_wait(ovl_id_t id)
+{
+    if (id < ovl_count && ovl_inflight == id) {
+        ovl_dma_finish(1);
+    }
+}
+
+void ovl_enter(ovl_id_t id)
+{
+    if (ovl_acquire(id) == NULL) {
+        ovl_port_fault(id);
+    }
+    ovl_release(id);
+}
+
+const ovl_stats_t *ovl_get_stats(ovl_id_t id)
+{
+    return id < ovl_count ? &ovl_stats[id] : NULL;
+}
+
+void *ovl_scratch_acquire(size_t min_len, size_t *len)
+{
+    size_t lo, n;
+
+    if (scratch_hi != scratch_lo) {
+        return NULL;
+    }
+    ovl_dma_finish(0);
+    n = ovl_scratch_gap(&lo);
+    if (n == 0 || n < min_len) {
+        return NULL;
+    }
+    scratch_lo = lo;
+    scratch_hi = lo + n;
+    *len = n;
+    return ovl_window + lo;
+}
+
+void ovl_scratch_release(void)
+{
+    scratch_lo = scratch_hi = 0;
+}
+
+size_t ovl_scratch_avail(void)
+{
+    size_t lo;
+
+    if (scratch_hi != scratch_lo) {
+        return 0;
+    }
+    ovl_dma_finish(0);
+    return ovl_scratch_gap(&lo);
+}
+
+const ovl_desc_t *ovl_get_desc(ovl_id_t id)
+{
+    return id < ovl_count ? ovl_desc(id) : NULL;
+}
+
+void *ovl_entry(ovl_id_t id, unsigned n)
+{
+    if (id >= ovl_count || n >= ovl_desc(id)->entry_count) {
+        return NULL;
+    }
+    // the entry list follows the descriptors
+    const uint32_t *list = (const uint32_t *)&ovl_table->desc[ovl_table->count];
+    return (void *)(uintptr_t)list[ovl_desc(id)->entry_first + n];
+}
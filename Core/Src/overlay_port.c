@@ -0,0 +1,115 @@
+#include "main.h"
+#include "overlay.h"
+
+/*============================================================================
+ * STM32G0 PORT FOR THE OVERLAY MANAGER
+ *============================================================================*/
+
+// DMA1 channel 1 is reserved for overlay loads
+#define OVL_DMA          DMA1
+#define OVL_DMA_CHANNEL  LL_DMA_CHANNEL_1
+
+// transfer started by ovl_port_dma_start(), checked when it completes
+static const ovl_desc_t *ovl_dma_image;
+
+// a packed image was decoded in ovl_port_dma_start(); result to report
+static uint8_t ovl_dma_sync;
+static int ovl_dma_sync_status;
+
+void ovl_port_init(void)
+{
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+    LL_DMA_DisableChannel(OVL_DMA, OVL_DMA_CHANNEL);
+    LL_DMA_ClearFlag_GI1(OVL_DMA);
+
+    // CRC-32 (0x04C11DB7), all-ones seed, no reflection, word input
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+    CRC->CR = 0;
+    CRC->POL = 0x04C11DB7U;
+    CRC->INIT = 0xFFFFFFFFU;
+}
+
+volatile uint32_t *ovl_port_crc_begin(void)
+{
+    CRC->CR |= CRC_CR_RESET;
+    return &CRC->DR;
+}
+
+uint32_t ovl_port_crc_end(void)
+{
+    return CRC->DR;
+}
+
+int ovl_port_copy(const ovl_desc_t *d)
+{
+    return ovl_image_load(d);
+}
+
+int ovl_port_check(const ovl_desc_t *d)
+{
+    return ovl_crc_image(d->vma, d->size) == d->crc ? 0 : -1;
+}
+
+void ovl_port_dma_start(const ovl_desc_t *d)
+{
+    LL_DMA_InitTypeDef dma = {0};
+
+    // DMA cannot decompress; packed images are decoded right here, which
+    // is why the Makefile keeps the prefetched overlays raw (OVL_RAW)
+    if (d->method != OVL_PACK_RAW) {
+        ovl_dma_sync_status = ovl_port_copy(d) == 0 ? OVL_DMA_DONE : OVL_DMA_ERROR;
+        ovl_dma_sync = 1;
+        return;
+    }
+    ovl_dma_image = d;
+
+    // memory-to-memory: the "peripheral" side is the flash image
+    dma.PeriphOrM2MSrcAddress  = (uint32_t)d->lma;
+    dma.MemoryOrM2MDstAddress  = (uint32_t)d->vma;
+    dma.Direction              = LL_DMA_DIRECTION_MEMORY_TO_MEMORY;
+    dma.Mode                   = LL_DMA_MODE_NORMAL;
+    dma.PeriphOrM2MSrcIncMode  = LL_DMA_PERIPH_INCREMENT;
+    dma.MemoryOrM2MDstIncMode  = LL_DMA_MEMORY_INCREMENT;
+    dma.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+    dma.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+    dma.NbData                 = d->size / 4u;
+    dma.PeriphRequest          = LL_DMAMUX_REQ_MEM2MEM;
+    dma.Priority               = LL_DMA_PRIORITY_LOW;
+
+    LL_DMA_DisableChannel(OVL_DMA, OVL_DMA_CHANNEL);
+    LL_DMA_ClearFlag_GI1(OVL_DMA);
+    LL_DMA_Init(OVL_DMA, OVL_DMA_CHANNEL, &dma);
+    LL_DMA_EnableChannel(OVL_DMA, OVL_DMA_CHANNEL);
+}
+
+int ovl_port_dma_poll(void)
+{
+    if (ovl_dma_sync) {
+        ovl_dma_sync = 0;
+        return ovl_dma_sync_status;
+    }
+    if (LL_DMA_IsActiveFlag_TE1(OVL_DMA)) {
+        LL_DMA_DisableChannel(OVL_DMA, OVL_DMA_CHANNEL);
+        LL_DMA_ClearFlag_GI1(OVL_DMA);
+        return OVL_DMA_ERROR;
+    }
+    if (!LL_DMA_IsActiveFlag_TC1(OVL_DMA)) {
+        return OVL_DMA_BUSY;
+    }
+    LL_DMA_DisableChannel(OVL_DMA, OVL_DMA_CHANNEL);
+    LL_DMA_ClearFlag_GI1(OVL_DMA);
+
+    // the DMA cannot feed the CRC unit as it copies; check from SRAM
+    if (ovl_port_check(ovl_dma_image) != 0) {
+        return OVL_DMA_ERROR;
+    }
+    return OVL_DMA_DONE;
+}
+
+void ovl_port_fault(ovl_id_t id)
+{
+    (void)id;
+    __disable_irq();
+    while (1) {
+    }
+}
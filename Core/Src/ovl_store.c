@@ -0,0 +1,108 @@
+#include "overlay.h"
+
+/*============================================================================
+ * IMAGE LOADING
+ *============================================================================*/
+
+int ovl_image_load(const ovl_desc_t *d)
+{
+    uint32_t crc;
+
+    switch (d->method) {
+    case OVL_PACK_RAW:
+        if (d->packed_size != d->size) {
+            return -1;
+        }
+        ovl_copy_words_crc(d->vma, d->lma, d->size, ovl_port_crc_begin());
+        crc = ovl_port_crc_end();
+        break;
+    case OVL_PACK_LZ4:
+        if (ovl_lz4_decode(d->vma, d->size, d->lma, d->packed_size) != (int)d->size) {
+            return -1;
+        }
+        // the decoder works bytewise; checksum the result from SRAM
+        crc = ovl_crc_image(d->vma, d->size);
+        break;
+    default:
+        return -1;
+    }
+    return crc == d->crc ? 0 : -1;
+}
+
+uint32_t ovl_crc_image(const void *p, size_t len)
+{
+    ovl_crc_words(p, len, ovl_port_crc_begin());
+    return ovl_port_crc_end();
+}
+
+
+/*============================================================================
+ * LZ4 BLOCK DECODER
+ *============================================================================*/
+
+/*
+ * Sequence: token (literal length << 4 | match length - 4), length
+ * extension bytes while 255, literals, 16-bit little-endian offset,
+ * match length extension. The last sequence ends after its literals.
+ */
+
+__attribute__((section(".RamFunc")))
+static size_t lz4_length(const uint8_t **ip, const uint8_t *iend, size_t len)
+{
+    unsigned b;
+
+    if (len != 15) {
+        return len;
+    }
+    do {
+        if (*ip >= iend) {
+            return SIZE_MAX;
+        }
+        b = *(*ip)++;
+        len += b;
+    } while (b == 255);
+    return len;
+}
+
+__attribute__((section(".RamFunc")))
+int ovl_lz4_decode(uint8_t *dst, size_t dst_len, const uint8_t *src, size_t src_len)
+{
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + src_len;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_len;
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+        size_t len = lz4_length(&ip, iend, token >> 4);
+
+        if (len > (size_t)(iend - ip) || len > (size_t)(oend - op)) {
+            return -1;
+        }
+        while (len--) {
+            *op++ = *ip++;
+        }
+        if (ip == iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return -1;
+        }
+        size_t off = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        len = lz4_length(&ip, iend, token & 15u);
+        if (len == SIZE_MAX || off == 0 || off > (size_t)(op - dst)
+            || len + 4u > (size_t)(oend - op)) {
+            return -1;
+        }
+        len += 4u;
+
+        // may overlap the bytes being written (run-length style matches)
+        const uint8_t *m = op - off;
+        while (len--) {
+            *op++ = *m++;
+        }
+    }
+    return (int)(op - dst);
+}
@@ -963,6 +963,170 @@ br_rsa_oaep_decrypt br_rsa_i62_oaep_decrypt_get(void);
 uint32_t br_rsa_i15_public(unsigned char *x, size_t xlen,
 	const br_rsa_public_key *pk);
 
+/**
+ * \brief Workspace length for `br_rsa_i15_public_ws()`.
+ *
+ * The length depends on the actual size of the modulus, not on
+ * `BR_MAX_RSA_SIZE`: for a 2048-bit key, it is a bit more than a
+ * kilobyte.
+ *
+ * \param pk   RSA public key.
+ * \return  the workspace length (in bytes), or 0 if the key is not
+ *          supported by the "i15" engine.
+ */
+size_t br_rsa_i15_public_ws_len(const br_rsa_public_key *pk);
+
+/**
+ * \brief RSA public key engine "i15", with a caller-provided workspace.
+ *
+ * This computes the same value as `br_rsa_i15_public()`, but keeps its
+ * temporaries in `ws` instead of the stack (or `BR_SCRATCH_ACQUIRE`).
+ * The workspace must be aligned on a 16-bit boundary, and hold at
+ * least `br_rsa_i15_public_ws_len(pk)` bytes; its contents are not
+ * preserved.
+ *
+ * \param x        operand to exponentiate.
+ * \param xlen     length of the operand (in bytes).
+ * \param pk       RSA public key.
+ * \param ws       workspace.
+ * \param ws_len   workspace length (in bytes).
+ * \return  1 on success, 0 on error (including a short workspace).
+ */
+uint32_t br_rsa_i15_public_ws(unsigned char *x, size_t xlen,
+	const br_rsa_public_key *pk, void *ws, size_t ws_len);
+
+/**
+ * \brief Maximum modulus size (in bits) for `br_rsa_i15_pubctx`.
+ *
+ * The context embeds two decoded integers of that size. The default
+ * covers every key the engine accepts (only keys of that size when
+ * `BR_I15_FIXED_BITS` is set); it may be lowered at build time when
+ * only smaller keys are in use.
+ */
+#ifndef BR_RSA_I15_PUBCTX_MAX_BITS
+#if defined BR_I15_FIXED_BITS && BR_I15_FIXED_BITS
+#define BR_RSA_I15_PUBCTX_MAX_BITS   BR_I15_FIXED_BITS
+#else
+#define BR_RSA_I15_PUBCTX_MAX_BITS   4096
+#endif
+#endif
+
+/**
+ * \brief Length (in 16-bit words) of a decoded integer in
+ * `br_rsa_i15_pubctx`, header word included.
+ *
+ * The value is even, so that the first value word of both integers
+ * stays aligned on a 32-bit boundary.
+ */
+#define BR_RSA_I15_PUBCTX_WORDS \
+	((2 + ((BR_RSA_I15_PUBCTX_MAX_BITS + 14) / 15)) & ~1)
+
+/**
+ * \brief Precomputed RSA public key, for the "i15" engine.
+ *
+ * The values that `br_rsa_i15_public()` derives from the key on every
+ * call are computed once by `br_rsa_i15_pubctx_init()`: the decoded
+ * modulus, its Montgomery constant, and R^2 mod N, with which the
+ * conversion of the operand to Montgomery representation is a single
+ * Montgomery product. The exponent is referenced, not copied, and must
+ * remain valid as long as the context is used.
+ *
+ * Contents are opaque and may be placed in read-only memory once
+ * computed; `tools/rsakey.py` generates them at build time from PEM or
+ * DER keys.
+ */
+typedef struct {
+#ifndef BR_DOXYGEN_IGNORE
+	uint16_t m0i;
+	uint16_t m[BR_RSA_I15_PUBCTX_WORDS];
+	uint16_t r2[BR_RSA_I15_PUBCTX_WORDS];
+	size_t nlen;
+	const unsigned char *e;
+	size_t elen;
+#endif
+} br_rsa_i15_pubctx;
+
+/**
+ * \brief Precompute an RSA public key for the "i15" engine.
+ *
+ * Returned value is 1 on success, 0 on error (modulus is even, or
+ * larger than `BR_RSA_I15_PUBCTX_MAX_BITS`).
+ *
+ * \param ctx   context to initialise.
+ * \param pk    RSA public key.
+ * \return  1 on success, 0 on error.
+ */
+uint32_t br_rsa_i15_pubctx_init(br_rsa_i15_pubctx *ctx,
+	const br_rsa_public_key *pk);
+
+/**
+ * \brief RSA public key engine "i15", with a precomputed key.
+ *
+ * This computes the same value as `br_rsa_i15_public()`, with the
+ * per-key work done beforehand in `br_rsa_i15_pubctx_init()`.
+ *
+ * \param x      operand to exponentiate.
+ * \param xlen   length of the operand (in bytes).
+ * \param ctx    precomputed RSA public key.
+ * \return  1 on success, 0 on error.
+ */
+uint32_t br_rsa_i15_public_ctx(unsigned char *x, size_t xlen,
+	const br_rsa_i15_pubctx *ctx);
+
+/**
+ * \brief RSA public key engine "i15", for a batch of operands under
+ * one precomputed key.
+ *
+ * Each `sigs[i]` (for `i` from 0 to `n-1`) is a buffer of exactly
+ * `ctx->nlen` bytes (the length of the modulus), exponentiated in
+ * place as with `br_rsa_i15_public_ctx()`. The workspace is obtained
+ * once for the whole batch. If `results` is not `NULL`, `results[i]`
+ * receives 1 or 0 for `sigs[i]` (0 meaning that the operand was not
+ * lower than the modulus; the buffer then holds an unspecified value).
+ *
+ * \param ctx       precomputed RSA public key.
+ * \param sigs      operands to exponentiate.
+ * \param n         number of operands.
+ * \param results   per-operand outcome (or `NULL`).
+ * \return  the number of operands that were processed successfully.
+ */
+size_t br_rsa_i15_public_batch(const br_rsa_i15_pubctx *ctx,
+	unsigned char *const *sigs, size_t n, uint32_t *results);
+
+/**
+ * \brief Length (in 16-bit words) of a decoded prime factor in
+ * `br_rsa_i15_privctx`, header word included (even).
+ */
+#define BR_RSA_I15_PRIVCTX_WORDS \
+	((2 + (((BR_RSA_I15_PUBCTX_MAX_BITS + 1) / 2 + 14) / 15)) & ~1)
+
+/**
+ * \brief Precomputed RSA private key (CRT parameters), for the "i15"
+ * engine.
+ *
+ * Holds, for each prime factor, its decoded value, Montgomery constant
+ * and R^2 mod p (or q), and the CRT coefficient iq already in
+ * Montgomery representation modulo p. The reduced private exponents
+ * are referenced, not copied. Such contexts are produced at build time
+ * by `tools/rsakey.py` and kept in read-only memory.
+ */
+typedef struct {
+#ifndef BR_DOXYGEN_IGNORE
+	uint32_t n_bitlen;
+	uint16_t p0i;
+	uint16_t p[BR_RSA_I15_PRIVCTX_WORDS];
+	uint16_t r2p[BR_RSA_I15_PRIVCTX_WORDS];
+	uint16_t iq[BR_RSA_I15_PRIVCTX_WORDS];
+	uint16_t q[BR_RSA_I15_PRIVCTX_WORDS];
+	uint16_t r2q[BR_RSA_I15_PRIVCTX_WORDS];
+	uint16_t q0i;
+	const unsigned char *dp;
+	size_t dplen;
+	const unsigned char *dq;
+	size_t dqlen;
+#endif
+} br_rsa_i15_privctx;
+
 /**
  * \brief RSA signature verification engine "i15" (PKCS#1 v1.5 signatures).
  *
@@ -1045,6 +1209,26 @@ uint32_t br_rsa_i15_pss_sign(const br_prng_class **rng,
 	const unsigned char *hash_value, size_t salt_len,
 	const br_rsa_private_key *sk, unsigned char *x);
 
+/*
+ * RSA "i16" engine. Like i15, but with full 16-bit words: a 2048-bit
+ * modulus takes 128 words instead of 137, and a 16x16 product still
+ * fits the 32-bit result of the Cortex M0/M0+ multiplier. Only the
+ * public-key operation is implemented.
+ */
+
+/**
+ * \brief RSA public key engine "i16".
+ *
+ * \see br_rsa_public
+ *
+ * \param x      operand to exponentiate.
+ * \param xlen   length of the operand (in bytes).
+ * \param pk     RSA public key.
+ * \return  1 on success, 0 on error.
+ */
+uint32_t br_rsa_i16_public(unsigned char *x, size_t xlen,
+	const br_rsa_public_key *pk);
+
 /**
  * \brief Get "default" RSA implementation (public-key operations).
  *
@@ -69,6 +69,45 @@
 #define BR_SLOW_MUL15   1
  */
 
+/*
+ * When BR_I15_COMBA is enabled, the "i15" Montgomery multiplication
+ * (br_i15_montymul()) scans products column by column (Comba) with the
+ * reduction interleaved, instead of the default row-by-row loop. This
+ * writes each output word only once, which pays off when memory
+ * accesses are slow compared with multiplications (e.g. Cortex-M0+).
+ *
+#define BR_I15_COMBA   1
+ */
+
+/*
+ * When BR_I15_SWAR is enabled, br_i15_zero(), the conditional add and
+ * subtract, CCOPY and the window lookup of br_i15_modpow_opt() use
+ * SWAR versions that handle two 15-bit words (or four bytes) per
+ * 32-bit operation, for cores with no wider registers. This relies on
+ * may_alias (GCC and Clang) for the 32-bit accesses.
+ *
+#define BR_I15_SWAR   1
+ */
+
+/*
+ * When BR_I15_FIXED_BITS is defined to a modulus size (e.g. 2048), the
+ * "i15" Montgomery kernels and br_i15_modpow_vartime() are built for
+ * moduli of exactly that many 15-bit words: the length is a constant,
+ * loop bounds and remainders are resolved at compile time, and the
+ * "i15" RSA public-key functions size their temporaries for it and
+ * reject keys of any other size.
+ *
+#define BR_I15_FIXED_BITS   2048
+ */
+
+/*
+ * BR_MAX_RSA_SIZE (in bits, multiple of 64) caps the modulus size of
+ * every RSA engine, and with it their stack buffers. The default is
+ * 4096; lower it when only smaller keys are in use.
+ *
+#define BR_MAX_RSA_SIZE   2048
+ */
+
 /*
  * When BR_CT_MUL31 is enabled, multiplications of 31-bit values (used
  * in the "i31" big integer implementation) use an alternate implementation
@@ -244,4 +283,21 @@
 #define BR_BE_UNALIGNED   1
  */
 
+/*
+ * When BR_SCRATCH_ACQUIRE is defined, it names a function through which
+ * the application lends workspace memory, and BR_SCRATCH_RELEASE the
+ * function that gives it back:
+ *
+ *   void *BR_SCRATCH_ACQUIRE(size_t min_len, size_t *len);
+ *   void BR_SCRATCH_RELEASE(void);
+ *
+ * The acquire function returns a 32-bit aligned buffer of at least
+ * min_len bytes and stores its actual size in *len, or returns NULL.
+ * br_rsa_i15_public() then takes its temporaries from there and only
+ * uses its stack buffer when nothing is lent.
+ *
+#define BR_SCRATCH_ACQUIRE   app_scratch_acquire
+#define BR_SCRATCH_RELEASE   app_scratch_release
+ */
+
 #endif
@@ -52,8 +52,14 @@
  * (some computations in RSA key generation rely on the factor size being
  * no more than 23833 bits). RSA key sizes beyond 3072 bits don't make a
  * lot of sense anyway.
+ *
+ * It may be lowered at build time (e.g. -DBR_MAX_RSA_SIZE=2048) when
+ * only smaller keys are in use; this shrinks the stack buffers of the
+ * RSA engines accordingly.
  */
+#ifndef BR_MAX_RSA_SIZE
 #define BR_MAX_RSA_SIZE   4096
+#endif
 
 /*
  * Minimum size for a RSA modulus (in bits); this value is used only to
@@ -81,6 +87,14 @@
  */
 #define BR_MAX_EC_SIZE   528
 
+/*
+ * Workspace provided by the application (see config.h).
+ */
+#ifdef BR_SCRATCH_ACQUIRE
+void *BR_SCRATCH_ACQUIRE(size_t min_len, size_t *len);
+void BR_SCRATCH_RELEASE(void);
+#endif
+
 /*
  * Some macros to recognize the current architecture. Right now, we are
  * interested into automatically recognizing architecture with efficient
@@ -905,7 +919,28 @@ LE0(int32_t x)
  */
 void br_ccopy(uint32_t ctl, void *dst, const void *src, size_t len);
 
+/*
+ * 32-bit word that may alias objects of any type. The SWAR ("SIMD
+ * within a register") helpers handle four bytes or two 16-bit words
+ * per operation through it.
+ */
+#if BR_GCC || BR_CLANG
+typedef uint32_t br_swar32 __attribute__((__may_alias__));
+#else
+typedef uint32_t br_swar32;
+#endif
+
+/*
+ * Same as br_ccopy(), four bytes at a time where dst[] and src[] have
+ * the same alignment modulo 4.
+ */
+void br_ccopy_swar(uint32_t ctl, void *dst, const void *src, size_t len);
+
+#if BR_I15_SWAR
+#define CCOPY   br_ccopy_swar
+#else
 #define CCOPY   br_ccopy
+#endif
 
 /*
  * Compute the bit length of a 32-bit integer. Returned value is between 0
@@ -1533,11 +1568,75 @@ uint32_t br_i31_moddiv(uint32_t *x, const uint32_t *y,
  * FIXME: document "i15" functions.
  */
 
+/*
+ * Number of value words of modulus m[]. When BR_I15_FIXED_BITS is set,
+ * the Montgomery kernels (montymul, montysqr, from_monty) and the
+ * variable-time modpow are built for moduli of that size only and get
+ * the word count as a constant; the RSA entry points reject others.
+ */
+#if BR_I15_FIXED_BITS
+#define BR_I15_FIXED_LEN   ((BR_I15_FIXED_BITS + 14) / 15)
+#define BR_I15_MLEN(m)     ((void)(m), (size_t)BR_I15_FIXED_LEN)
+#if BR_I15_FIXED_BITS > BR_MAX_RSA_SIZE
+#error "BR_I15_FIXED_BITS exceeds BR_MAX_RSA_SIZE"
+#endif
+#else
+#define BR_I15_MLEN(m)     ((size_t)(((m)[0] + 15) >> 4))
+#endif
+
+/*
+ * SWAR versions of br_i15_zero(), br_i15_add() and br_i15_sub(), with
+ * two words per 32-bit operation (i15_swar.c). br_i15_lookup_swar() is
+ * the constant-time window lookup of br_i15_modpow_opt(): words 1 to
+ * mwlen-1 of d[] receive those of entry idx of tab[], which holds
+ * entries 1 to num-1 of mwlen words each, or zero if idx is not in
+ * that range. With BR_I15_SWAR, the i15 code uses these in place of
+ * the plain versions (through br_i15_zero(), BR_I15_ADD and
+ * BR_I15_SUB), which remain available.
+ */
+void br_i15_zero_swar(uint16_t *x, uint16_t bit_len);
+
+uint32_t br_i15_add_swar(uint16_t *a, const uint16_t *b, uint32_t ctl);
+
+uint32_t br_i15_sub_swar(uint16_t *a, const uint16_t *b, uint32_t ctl);
+
+void br_i15_lookup_swar(uint16_t *d, const uint16_t *tab, size_t mwlen,
+	uint32_t num, uint32_t idx);
+
 static inline void
 br_i15_zero(uint16_t *x, uint16_t bit_len)
 {
+#if BR_I15_SWAR
+	br_i15_zero_swar(x, bit_len);
+#else
 	*x ++ = bit_len;
 	memset(x, 0, ((bit_len + 15) >> 4) * sizeof *x);
+#endif
+}
+
+/*
+ * Constant-time conditional copy of len words: d[] is set to s[] if
+ * ctl is 1, left unchanged if ctl is 0. With BR_I15_SWAR, arrays with
+ * the same alignment modulo 4 go to br_ccopy_swar() (32 bits at a
+ * time); otherwise, this is CCOPY a 16-bit word rather than a byte at
+ * a time.
+ */
+static inline void
+br_i15_ccopy(uint32_t ctl, uint16_t *d, const uint16_t *s, size_t len)
+{
+	uint16_t mask;
+
+#if BR_I15_SWAR
+	if ((((uintptr_t)d ^ (uintptr_t)s) & 3) == 0) {
+		br_ccopy_swar(ctl, d, s, len * sizeof *d);
+		return;
+	}
+#endif
+	mask = (uint16_t)-ctl;
+	while (len -- > 0) {
+		*d ^= mask & (*d ^ *s ++);
+		d ++;
+	}
 }
 
 uint32_t br_i15_iszero(const uint16_t *x);
@@ -1548,19 +1647,146 @@ uint32_t br_i15_add(uint16_t *a, const uint16_t *b, uint32_t ctl);
 
 uint32_t br_i15_sub(uint16_t *a, const uint16_t *b, uint32_t ctl);
 
+#if BR_I15_SWAR
+#define BR_I15_ADD   br_i15_add_swar
+#define BR_I15_SUB   br_i15_sub_swar
+#else
+#define BR_I15_ADD   br_i15_add
+#define BR_I15_SUB   br_i15_sub
+#endif
+
 void br_i15_muladd_small(uint16_t *x, uint16_t z, const uint16_t *m);
 
+/*
+ * Column sum: acc += a[0]*b[0] + a[1]*b[-1] + ... + a[n-1]*b[-(n-1)],
+ * acc[] being a 64-bit accumulator (low word first). a[] is read
+ * upwards and b[] downwards, as the products of one column of a
+ * product-scanning multiplication.
+ */
+void br_i15_dot_column(uint32_t *acc, const uint16_t *a, const uint16_t *b,
+	size_t n);
+
+#if BR_ARMEL_CORTEXM_GCC
+/*
+ * Thumb-1 frame shared by the i15 and i16 column kernels. lo and hi
+ * are the accumulator words, held in locals so that they are stack
+ * operands (every low register is clobbered, so none is left to
+ * address acc[]); a, b and n are as in br_i15_dot_column(). The
+ * n mod 4 leftover products are added one by one, then quad runs for
+ * each group of four: it must add a[0..3]*b[0..-3], found at
+ * [r4, #0..6] and [r5, #6..0], into r3:r2. r0, r1 and r7 are free
+ * there, and r6 holds 0 for the carries.
+ */
+#define BR_DOT_COLUMN_THUMB(lo, hi, a, b, n, quad) \
+	asm volatile ( \
+	"ldr	r2, %[lo]\n\t" \
+	"ldr	r3, %[hi]\n\t" \
+	"ldr	r4, %[a]\n\t" \
+	"ldr	r5, %[b]\n\t" \
+	"ldr	r7, %[n]\n\t" \
+	"lsl	r0, r7, #1\n\t" \
+	"add	r0, r4, r0\n\t" \
+	"mov	r8, r0\n\t" \
+	"eor	r6, r6\n\t" \
+	"mov	r0, #3\n\t" \
+	"and	r7, r0\n\t" \
+	"beq	quad%=\n" \
+	"one%=:\n\t" \
+	"ldrh	r0, [r4, #0]\n\t" \
+	"ldrh	r1, [r5, #0]\n\t" \
+	"add	r4, #2\n\t" \
+	"sub	r5, #2\n\t" \
+	"mul	r0, r1\n\t" \
+	"add	r2, r2, r0\n\t" \
+	"adc	r3, r6\n\t" \
+	"sub	r7, #1\n\t" \
+	"bne	one%=\n" \
+	"quad%=:\n\t" \
+	"cmp	r4, r8\n\t" \
+	"beq	done%=\n\t" \
+	"sub	r5, #6\n" \
+	"loop%=:\n" \
+	quad \
+	"\tadd	r4, #8\n\t" \
+	"sub	r5, #8\n\t" \
+	"cmp	r4, r8\n\t" \
+	"bne	loop%=\n" \
+	"done%=:\n\t" \
+	"str	r2, %[lo]\n\t" \
+	"str	r3, %[hi]\n" \
+	: [lo] "+m" (lo), [hi] "+m" (hi) \
+	: [a] "m" (a), [b] "m" (b), [n] "m" (n) \
+	: "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "memory")
+#endif
+
+/*
+ * Montgomery multiplication: d <- x*y/R mod m. d[] must not overlap
+ * x[], y[] or m[]. The column-wise (product-scanning) implementation
+ * is used when BR_I15_COMBA is set.
+ */
 void br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
 	const uint16_t *m, uint16_t m0i);
 
+/*
+ * Montgomery squaring: d <- x*x/R mod m, like br_i15_montymul(d, x, x,
+ * m, m0i), with about a quarter fewer multiplications. d[] must not
+ * overlap x[] or m[].
+ */
+void br_i15_montysqr(uint16_t *d, const uint16_t *x,
+	const uint16_t *m, uint16_t m0i);
+
+/*
+ * Lazy ("almost Montgomery") variants: the final conditional
+ * subtraction is skipped, and the operands and the result lie in
+ * [0, 2m) rather than [0, m). This is sound only when R > 4m, i.e.
+ * when the top word of m[] has at least two unused bits, as reported
+ * by br_i15_lazy_ok(). br_i15_from_monty() accepts a lazy value and
+ * returns it fully reduced.
+ */
+void br_i15_montymul_lazy(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i);
+
+void br_i15_montysqr_lazy(uint16_t *d, const uint16_t *x,
+	const uint16_t *m, uint16_t m0i);
+
+static inline uint32_t
+br_i15_lazy_ok(const uint16_t *m)
+{
+	return (m[0] & 15) <= 13;
+}
+
 void br_i15_to_monty(uint16_t *x, const uint16_t *m);
 
+/*
+ * d <- R^2 mod m (R = 2^(15*len), len being the number of value words
+ * of m[]); t is a temporary of the size of m[]. This is a few word
+ * shifts, doublings and Montgomery squarings, about three times faster
+ * than converting 1 with br_i15_to_monty() twice. Not constant-time
+ * with regards to the bit length of m[].
+ */
+void br_i15_rsquare(uint16_t *d, const uint16_t *m, uint16_t m0i,
+	uint16_t *t);
+
 void br_i15_modpow(uint16_t *x, const unsigned char *e, size_t elen,
 	const uint16_t *m, uint16_t m0i, uint16_t *t1, uint16_t *t2);
 
 uint32_t br_i15_modpow_opt(uint16_t *x, const unsigned char *e, size_t elen,
 	const uint16_t *m, uint16_t m0i, uint16_t *tmp, size_t twlen);
 
+/*
+ * Variable-time modular exponentiation, for public exponents only (the
+ * sequence of operations depends on e[] but not on x[]). Exponents of
+ * the form 2^k+1 (3, 65537) take k squarings and one multiplication;
+ * others go through left-to-right square-and-multiply. x[] must be
+ * reduced modulo m[]; t1 and t2 are temporaries of the size of m[].
+ * If r2 is not NULL, it holds R^2 mod m (R = 2^(15*len), len being the
+ * number of value words of m[]) and replaces br_i15_to_monty() with a
+ * single Montgomery product.
+ */
+void br_i15_modpow_vartime(uint16_t *x, const unsigned char *e, size_t elen,
+	const uint16_t *m, uint16_t m0i, const uint16_t *r2,
+	uint16_t *t1, uint16_t *t2);
+
 void br_i15_encode(void *dst, size_t len, const uint16_t *x);
 
 uint32_t br_i15_decode_mod(uint16_t *x,
@@ -1584,6 +1810,64 @@ void br_i15_mulacc(uint16_t *d, const uint16_t *a, const uint16_t *b);
 uint32_t br_i15_moddiv(uint16_t *x, const uint16_t *y,
 	const uint16_t *m, uint16_t m0i, uint16_t *t);
 
+/* ==================================================================== */
+
+/*
+ * "i16" functions: the same layout as "i15", with full 16-bit words.
+ * Word 0 is the bit length itself (for i15 it is an encoded length
+ * with the same (x[0] + 15) >> 4 word count); words 1 and up are the
+ * value, least significant first. A 16x16 product can take all 32
+ * bits, so sums of products are carried in 64-bit accumulators.
+ * Moduli must be odd; d[] of br_i16_montymul() must not overlap its
+ * inputs.
+ */
+
+static inline void
+br_i16_zero(uint16_t *x, uint16_t bit_len)
+{
+	*x ++ = bit_len;
+	memset(x, 0, ((bit_len + 15) >> 4) * sizeof *x);
+}
+
+uint32_t br_i16_bit_length(const uint16_t *x, size_t xlen);
+
+void br_i16_decode(uint16_t *x, const void *src, size_t len);
+
+uint32_t br_i16_decode_mod(uint16_t *x,
+	const void *src, size_t len, const uint16_t *m);
+
+void br_i16_encode(void *dst, size_t len, const uint16_t *x);
+
+uint16_t br_i16_ninv16(uint16_t x);
+
+uint32_t br_i16_sub(uint16_t *a, const uint16_t *b, uint32_t ctl);
+
+/*
+ * Column sum as br_i15_dot_column(), for 16-bit words.
+ */
+void br_i16_dot_column(uint32_t *acc, const uint16_t *a, const uint16_t *b,
+	size_t n);
+
+void br_i16_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i);
+
+void br_i16_from_monty(uint16_t *x, const uint16_t *m, uint16_t m0i);
+
+/*
+ * d <- R^2 mod m (R = 2^(16*len)); t is a temporary of the size of m[].
+ * Not constant-time with regards to the bit length of m[].
+ */
+void br_i16_rsquare(uint16_t *d, const uint16_t *m, uint16_t m0i,
+	uint16_t *t);
+
+/*
+ * Variable-time modular exponentiation, as br_i15_modpow_vartime().
+ * When r2 is NULL, R^2 mod m is computed with br_i16_rsquare().
+ */
+void br_i16_modpow_vartime(uint16_t *x, const unsigned char *e, size_t elen,
+	const uint16_t *m, uint16_t m0i, const uint16_t *r2,
+	uint16_t *t1, uint16_t *t2);
+
 /*
  * Variant of br_i31_modpow_opt() that internally uses 64x64->128
  * multiplications. It expects the same parameters as br_i31_modpow_opt(),
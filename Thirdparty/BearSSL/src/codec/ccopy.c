@@ -25,7 +25,7 @@
 #include "inner.h"
 
 /* see inner.h */ 
-void __attribute__((section(".ovl_rsa")))
+void
 br_ccopy(uint32_t ctl, void *dst, const void *src, size_t len)
 {
 	unsigned char *d;
@@ -42,3 +42,36 @@ br_ccopy(uint32_t ctl, void *dst, const void *src, size_t len)
 		d ++;
 	}
 }
+
+/* see inner.h */
+void
+br_ccopy_swar(uint32_t ctl, void *dst, const void *src, size_t len)
+{
+	unsigned char *d;
+	const unsigned char *s;
+	uint32_t mask;
+
+	d = dst;
+	s = src;
+	mask = -ctl;
+	if ((((uintptr_t)d ^ (uintptr_t)s) & 3) == 0) {
+		while (len > 0 && ((uintptr_t)d & 3) != 0) {
+			*d ^= mask & (*d ^ *s ++);
+			d ++;
+			len --;
+		}
+		while (len >= 4) {
+			uint32_t x;
+
+			x = *(br_swar32 *)d;
+			*(br_swar32 *)d = x ^ (mask & (x ^ *(const br_swar32 *)s));
+			d += 4;
+			s += 4;
+			len -= 4;
+		}
+	}
+	while (len -- > 0) {
+		*d ^= mask & (*d ^ *s ++);
+		d ++;
+	}
+}
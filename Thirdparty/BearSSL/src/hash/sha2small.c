@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+#define CH(X, Y, Z)    ((((Y) ^ (Z)) & (X)) ^ (Z))
+#define MAJ(X, Y, Z)   (((Y) & (Z)) | (((Y) | (Z)) & (X)))
+
+#define ROTR(x, n)    (((uint32_t)(x) << (32 - (n))) | ((uint32_t)(x) >> (n)))
+
+#define BSG2_0(x)      (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define BSG2_1(x)      (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define SSG2_0(x)      (ROTR(x, 7) ^ ROTR(x, 18) ^ (uint32_t)((x) >> 3))
+#define SSG2_1(x)      (ROTR(x, 17) ^ ROTR(x, 19) ^ (uint32_t)((x) >> 10))
+
+static const uint32_t K[64] = {
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+	0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+	0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+	0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+	0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+	0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+	0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+	0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+	0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+	0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+	0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+	0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+	0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+	0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/*
+ * The round function is written for small cores: it must fit in the
+ * 1 kB overlay bank next to the rest of this file, and Cortex-M0+ has
+ * only eight low registers.
+ *
+ *  - The loop is not unrolled, and the message schedule is a 16-word
+ *    circular buffer, computed one word ahead of its use.
+ *
+ *  - The working variables a..h are not renamed after each round
+ *    (six loads and stores that buy nothing when they live on the
+ *    stack anyway). They sit in a window of s[] that slides down one
+ *    word per round: round i reads a..h from p[0..7], adds T1 into d,
+ *    which becomes the next e, and writes the next a to p[-1]. After
+ *    16 rounds the window is at the bottom of s[] and is moved back to
+ *    the top.
+ *
+ *  - Blocks at a 32-bit aligned address are loaded a word at a time
+ *    and byte-swapped with REV.
+ */
+
+/* see inner.h */
+void
+br_sha2small_round(const unsigned char *buf, uint32_t *val)
+{
+	uint32_t w[16], s[24];
+	int i, j;
+
+#if BR_ARMEL_CORTEXM_GCC
+	if (((uintptr_t)buf & 3) == 0) {
+		for (i = 0; i < 16; i ++) {
+			w[i] = __builtin_bswap32(((const br_swar32 *)buf)[i]);
+		}
+	} else
+#endif
+	{
+		for (i = 0; i < 16; i ++) {
+			w[i] = br_dec32be(buf + (i << 2));
+		}
+	}
+
+	memcpy(s + 16, val, 8 * sizeof *val);
+	for (j = 0; j < 64; j += 16) {
+		for (i = 0; i < 16; i ++) {
+			uint32_t *p;
+			uint32_t t1, t2;
+
+			if (j != 0) {
+				w[i] += SSG2_1(w[(i + 14) & 15]) + w[(i + 9) & 15]
+					+ SSG2_0(w[(i + 1) & 15]);
+			}
+			p = s + 16 - i;
+			t1 = p[7] + BSG2_1(p[4]) + CH(p[4], p[5], p[6])
+				+ K[j + i] + w[i];
+			t2 = BSG2_0(p[0]) + MAJ(p[0], p[1], p[2]);
+			p[3] += t1;
+			p[-1] = t1 + t2;
+		}
+		memcpy(s + 16, s, 8 * sizeof *s);
+	}
+	for (i = 0; i < 8; i ++) {
+		val[i] += s[16 + i];
+	}
+}
+
+static void
+sha2small_update(br_sha224_context *cc, const void *data, size_t len)
+{
+	const unsigned char *buf;
+	size_t ptr;
+
+	buf = data;
+	ptr = (size_t)cc->count & 63;
+	cc->count += (uint64_t)len;
+	while (len > 0) {
+		size_t clen;
+
+		/*
+		 * Whole blocks are compressed where they are, without
+		 * the copy through cc->buf.
+		 */
+		if (ptr == 0 && len >= 64) {
+			br_sha2small_round(buf, cc->val);
+			buf += 64;
+			len -= 64;
+			continue;
+		}
+		clen = 64 - ptr;
+		if (clen > len) {
+			clen = len;
+		}
+		memcpy(cc->buf + ptr, buf, clen);
+		ptr += clen;
+		buf += clen;
+		len -= clen;
+		if (ptr == 64) {
+			br_sha2small_round(cc->buf, cc->val);
+			ptr = 0;
+		}
+	}
+}
+
+static void
+sha2small_out(const br_sha224_context *cc, void *dst, int num)
+{
+	unsigned char buf[64];
+	uint32_t val[8];
+	size_t ptr;
+
+	ptr = (size_t)cc->count & 63;
+	memcpy(buf, cc->buf, ptr);
+	memcpy(val, cc->val, sizeof val);
+	buf[ptr ++] = 0x80;
+	if (ptr > 56) {
+		memset(buf + ptr, 0, 64 - ptr);
+		br_sha2small_round(buf, val);
+		memset(buf, 0, 56);
+	} else {
+		memset(buf + ptr, 0, 56 - ptr);
+	}
+	br_enc64be(buf + 56, cc->count << 3);
+	br_sha2small_round(buf, val);
+	br_range_enc32be(dst, val, num);
+}
+
+/* see bearssl_hash.h */
+void
+br_sha224_update(br_sha224_context *cc, const void *data, size_t len)
+{
+	sha2small_update(cc, data, len);
+}
+
+/* see bearssl_hash.h */
+void
+br_sha224_out(const br_sha224_context *cc, void *dst)
+{
+	sha2small_out(cc, dst, 7);
+}
+
+/* see bearssl_hash.h */
+void
+br_sha256_out(const br_sha256_context *cc, void *dst)
+{
+	sha2small_out(cc, dst, 8);
+}
@@ -25,7 +25,7 @@
 #include "inner.h"
 
 /* see inner.h */
-void __attribute__((section(".ovl_rsa")))
+void
 br_i15_decode(uint16_t *x, const void *src, size_t len)
 {
 	const unsigned char *buf;
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/* see inner.h */
+void
+br_i15_dot_column(uint32_t *acc, const uint16_t *a, const uint16_t *b,
+	size_t n)
+{
+	uint32_t lo, hi;
+
+	lo = acc[0];
+	hi = acc[1];
+#if BR_ARMEL_CORTEXM_GCC
+	/*
+	 * Four products of 15-bit words sum to less than 2^32, so they
+	 * are added up in a register and reach the 64-bit accumulator
+	 * with a single add/adc pair. Leftover products (n mod 4) are
+	 * done one by one first, by the frame in inner.h.
+	 */
+	BR_DOT_COLUMN_THUMB(lo, hi, a, b, n,
+"\n\
+	ldrh	r0, [r4, #0]                                       \n\
+	ldrh	r1, [r5, #6]                                       \n\
+	mul	r0, r1                                             \n\
+	ldrh	r1, [r4, #2]                                       \n\
+	ldrh	r7, [r5, #4]                                       \n\
+	mul	r1, r7                                             \n\
+	add	r0, r0, r1                                         \n\
+	ldrh	r1, [r4, #4]                                       \n\
+	ldrh	r7, [r5, #2]                                       \n\
+	mul	r1, r7                                             \n\
+	add	r0, r0, r1                                         \n\
+	ldrh	r1, [r4, #6]                                       \n\
+	ldrh	r7, [r5, #0]                                       \n\
+	mul	r1, r7                                             \n\
+	add	r0, r0, r1                                         \n\
+	add	r2, r2, r0                                         \n\
+	adc	r3, r6                                             \n\
+");
+#else
+	size_t t;
+
+	for (t = 0; t < n; t ++) {
+		uint32_t z;
+
+		z = MUL15(a[t], b[-(long)t]);
+		lo += z;
+		hi += (lo < z);
+	}
+#endif
+	acc[0] = lo;
+	acc[1] = hi;
+}
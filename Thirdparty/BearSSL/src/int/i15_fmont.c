@@ -30,7 +30,7 @@ br_i15_from_monty(uint16_t *x, const uint16_t *m, uint16_t m0i)
 {
 	size_t len, u, v;
 
-	len = (m[0] + 15) >> 4;
+	len = BR_I15_MLEN(m);
 	for (u = 0; u < len; u ++) {
 		uint32_t f, cc;
 
@@ -55,5 +55,5 @@ br_i15_from_monty(uint16_t *x, const uint16_t *m, uint16_t m0i)
 	 * carry, second call performs the subtraction only if the carry
 	 * is 0).
 	 */
-	br_i15_sub(x, m, NOT(br_i15_sub(x, m, 0)));
+	BR_I15_SUB(x, m, NOT(BR_I15_SUB(x, m, 0)));
 }
@@ -30,21 +30,32 @@ br_i15_modpow(uint16_t *x,
 	const unsigned char *e, size_t elen,
 	const uint16_t *m, uint16_t m0i, uint16_t *t1, uint16_t *t2)
 {
-	size_t mlen;
+	size_t mwlen;
+	uint16_t *base, *spare, *tt;
 	unsigned k;
 
-	mlen = ((m[0] + 31) >> 4) * sizeof m[0];
-	memcpy(t1, x, mlen);
+	mwlen = (m[0] + 31) >> 4;
+	memcpy(t1, x, mwlen * sizeof m[0]);
 	br_i15_to_monty(t1, m);
 	br_i15_zero(x, m[0]);
 	x[1] = 1;
+
+	/*
+	 * x[] accumulates the result; base holds the successive squares
+	 * and swaps roles with spare after each squaring, so that only
+	 * the conditional copy of the product moves data.
+	 */
+	base = t1;
+	spare = t2;
 	for (k = 0; k < ((unsigned)elen << 3); k ++) {
 		uint32_t ctl;
 
 		ctl = (e[elen - 1 - (k >> 3)] >> (k & 7)) & 1;
-		br_i15_montymul(t2, x, t1, m, m0i);
-		CCOPY(ctl, x, t2, mlen);
-		br_i15_montymul(t2, t1, t1, m, m0i);
-		memcpy(t1, t2, mlen);
+		br_i15_montymul(spare, x, base, m, m0i);
+		br_i15_ccopy(ctl, x, spare, mwlen);
+		br_i15_montysqr(spare, base, m, m0i);
+		tt = base;
+		base = spare;
+		spare = tt;
 	}
 }
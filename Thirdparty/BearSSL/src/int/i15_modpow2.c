@@ -25,16 +25,20 @@
 #include "inner.h"
 
 /* see inner.h */
-uint32_t __attribute__((section(".ovl_rsa")))
+uint32_t
 br_i15_modpow_opt(uint16_t *x,
 	const unsigned char *e, size_t elen,
 	const uint16_t *m, uint16_t m0i, uint16_t *tmp, size_t twlen)
 {
 	size_t mlen, mwlen;
-	uint16_t *t1, *t2, *base;
-	size_t u, v;
+	uint16_t *t1, *t2, *base, *cur, *spare, *tt;
+	size_t u;
 	uint32_t acc;
 	int acc_len, win_len;
+	void (*mul)(uint16_t *, const uint16_t *, const uint16_t *,
+		const uint16_t *, uint16_t);
+	void (*sqr)(uint16_t *, const uint16_t *,
+		const uint16_t *, uint16_t);
 
 	/*
 	 * Get modulus size.
@@ -61,9 +65,18 @@ br_i15_modpow_opt(uint16_t *x,
 	}
 
 	/*
-	 * Everything is done in Montgomery representation.
+	 * Everything is done in Montgomery representation. When R > 4m,
+	 * values are kept in [0, 2m) without the final subtraction of
+	 * each product; the choice depends on the modulus size only.
 	 */
 	br_i15_to_monty(x, m);
+	if (br_i15_lazy_ok(m)) {
+		mul = &br_i15_montymul_lazy;
+		sqr = &br_i15_montysqr_lazy;
+	} else {
+		mul = &br_i15_montymul;
+		sqr = &br_i15_montysqr;
+	}
 
 	/*
 	 * Compute window contents. If the window has size one bit only,
@@ -76,7 +89,7 @@ br_i15_modpow_opt(uint16_t *x,
 		memcpy(t2 + mwlen, x, mlen);
 		base = t2 + mwlen;
 		for (u = 2; u < ((unsigned)1 << win_len); u ++) {
-			br_i15_montymul(base + mwlen, base, x, m, m0i);
+			mul(base + mwlen, base, x, m, m0i);
 			base += mwlen;
 		}
 	}
@@ -93,7 +106,13 @@ br_i15_modpow_opt(uint16_t *x,
 	/*
 	 * We process bits from most to least significant. At each
 	 * loop iteration, we have acc_len bits in acc.
+	 *
+	 * The running value is in cur, which is x or t1: each squaring
+	 * writes into the other one and the two swap roles, so nothing
+	 * is copied until the end.
 	 */
+	cur = x;
+	spare = t1;
 	acc = 0;
 	acc_len = 0;
 	while (acc_len > 0 || elen > 0) {
@@ -120,8 +139,10 @@ br_i15_modpow_opt(uint16_t *x,
 		 * We could get exactly k bits. Compute k squarings.
 		 */
 		for (i = 0; i < k; i ++) {
-			br_i15_montymul(t1, x, x, m, m0i);
-			memcpy(x, t1, mlen);
+			sqr(spare, cur, m, m0i);
+			tt = cur;
+			cur = spare;
+			spare = tt;
 		}
 
 		/*
@@ -131,10 +152,16 @@ br_i15_modpow_opt(uint16_t *x,
 		 * already set; otherwise, we do a constant-time lookup.
 		 */
 		if (win_len > 1) {
+#if BR_I15_SWAR
+			t2[0] = m[0];
+			br_i15_lookup_swar(t2, t2 + mwlen, mwlen,
+				(uint32_t)1 << k, bits);
+#else
 			br_i15_zero(t2, m[0]);
 			base = t2 + mwlen;
 			for (u = 1; u < ((uint32_t)1 << k); u ++) {
 				uint32_t mask;
+				size_t v;
 
 				mask = -EQ(u, bits);
 				for (v = 1; v < mwlen; v ++) {
@@ -142,19 +169,24 @@ br_i15_modpow_opt(uint16_t *x,
 				}
 				base += mwlen;
 			}
+#endif
 		}
 
 		/*
 		 * Multiply with the looked-up value. We keep the
 		 * product only if the exponent bits are not all-zero.
 		 */
-		br_i15_montymul(t1, x, t2, m, m0i);
-		CCOPY(NEQ(bits, 0), x, t1, mlen);
+		mul(spare, cur, t2, m, m0i);
+		br_i15_ccopy(NEQ(bits, 0), cur, spare, mlen / sizeof m[0]);
 	}
 
 	/*
-	 * Convert back from Montgomery representation, and exit.
+	 * Convert back from Montgomery representation (this also fully
+	 * reduces a lazy value), and exit.
 	 */
-	br_i15_from_monty(x, m, m0i);
+	br_i15_from_monty(cur, m, m0i);
+	if (cur != x) {
+		memcpy(x, cur, mlen);
+	}
 	return 1;
 }
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+#if BR_I15_COMBA
+
+/*
+ * Product-scanning (Comba) Montgomery multiplication, built instead of
+ * the operand-scanning code of i15_montmul.c when BR_I15_COMBA is set.
+ * Column k gathers the products x[i]*y[k-i], then the reduction
+ * products f[j]*m[k-j]; below column len, the factor f[k] follows
+ * from the low word of the column and clears it. Each column is summed
+ * in registers by br_i15_dot_column() and only its low 15 bits and the
+ * carry leave it, so d[] is written once per word instead of once per
+ * word and per word of x[]. The factors are kept in d[], as in
+ * br_i15_montysqr(); d[] must therefore not overlap x[], y[] or m[].
+ */
+
+/*
+ * d <- (x*y + f*m)/R, not reduced; returns the carry out of the top
+ * word.
+ */
+static uint32_t
+montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i)
+{
+	size_t len, k, lo, n;
+	uint32_t acc[2], c;
+
+	d[0] = m[0];
+	len = BR_I15_MLEN(m);
+	if (len == 0) {
+		return 0;
+	}
+
+	/*
+	 * Value words are accessed with 1-based indices (x[1] is the
+	 * least significant). c is the carry out of the previous column,
+	 * which is below 2^25.
+	 *
+	 * Low columns (k < len): the factor of the column is computed
+	 * last, from the low word, which its product then clears.
+	 */
+	c = 0;
+	for (k = 0; k < len; k ++) {
+		uint32_t f, z;
+
+		acc[0] = c;
+		acc[1] = 0;
+		br_i15_dot_column(acc, x + 1, y + 1 + k, k + 1);
+		br_i15_dot_column(acc, d + 1, m + 1 + k, k);
+		f = MUL15(acc[0] & 0x7FFF, m0i) & 0x7FFF;
+		d[1 + k] = f;
+		z = MUL15(f, m[1]);
+		acc[0] += z;
+		acc[1] += (acc[0] < z);
+		c = (acc[0] >> 15) | (acc[1] << 17);
+	}
+
+	/*
+	 * High columns: each yields a result word, stored over the
+	 * factor slot that the column used last.
+	 */
+	for (lo = 1, n = len - 1; n > 0; lo ++, n --) {
+		k = lo + len - 1;
+		acc[0] = c;
+		acc[1] = 0;
+		br_i15_dot_column(acc, x + 1 + lo, y + 1 + k - lo, n);
+		br_i15_dot_column(acc, d + 1 + lo, m + 1 + k - lo, n);
+		d[lo] = acc[0] & 0x7FFF;
+		c = (acc[0] >> 15) | (acc[1] << 17);
+	}
+	d[len] = c & 0x7FFF;
+	return c >> 15;
+}
+
+/* see inner.h */
+void
+br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i)
+{
+	uint32_t dh;
+
+	/*
+	 * d[] may be greater than m[], but it is still lower than twice
+	 * the modulus.
+	 */
+	dh = montymul(d, x, y, m, m0i);
+	BR_I15_SUB(d, m, NEQ(dh, 0) | NOT(BR_I15_SUB(d, m, 0)));
+}
+
+/* see inner.h */
+void
+br_i15_montymul_lazy(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i)
+{
+	(void)montymul(d, x, y, m, m0i);
+}
+
+#endif
@@ -24,15 +24,20 @@
 
 #include "inner.h"
 
-/* see inner.h */
-void __attribute__((section(".ovl_rsa")))
-br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+#if !BR_I15_COMBA
+
+/*
+ * d <- (x*y + f*m)/R, not reduced; returns the carry out of the top
+ * word.
+ */
+static uint32_t
+montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
 	const uint16_t *m, uint16_t m0i)
 {
 	size_t len, len4, u, v;
 	uint32_t dh;
 
-	len = (m[0] + 15) >> 4;
+	len = BR_I15_MLEN(m);
 	len4 = len & ~(size_t)3;
 	br_i15_zero(d, m[0]);
 	dh = 0;
@@ -175,10 +180,30 @@ loop%=:                                                            \n\
 	 * Restore the bit length (it was overwritten in the loop above).
 	 */
 	d[0] = m[0];
+	return dh;
+}
+
+/* see inner.h */
+void
+br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i)
+{
+	uint32_t dh;
 
 	/*
 	 * d[] may be greater than m[], but it is still lower than twice
 	 * the modulus.
 	 */
-	br_i15_sub(d, m, NEQ(dh, 0) | NOT(br_i15_sub(d, m, 0)));
+	dh = montymul(d, x, y, m, m0i);
+	BR_I15_SUB(d, m, NEQ(dh, 0) | NOT(BR_I15_SUB(d, m, 0)));
 }
+
+/* see inner.h */
+void
+br_i15_montymul_lazy(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i)
+{
+	(void)montymul(d, x, y, m, m0i);
+}
+
+#endif
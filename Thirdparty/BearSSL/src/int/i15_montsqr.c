@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * Product-scanning (column-wise) Montgomery squaring. Column k of the
+ * square holds the products x[i]*x[j] with i + j = k; each product with
+ * i != j appears twice, so only i < j are computed and their sum is
+ * doubled, which halves the multiplications of the squaring part. The
+ * reduction is interleaved: the Montgomery factor f[k] of column k is
+ * known once the column sum is, and the products f[j]*m[k-j] are added
+ * into the same column accumulator. The factors are kept in d[]; a
+ * slot is overwritten with a result word only after its last use.
+ *
+ * The column accumulator is a 64-bit value in two 32-bit words; the
+ * column sums are computed by br_i15_dot_column().
+ */
+
+/*
+ * d <- (x*x + f*m)/R, not reduced; returns the carry out of the top
+ * word.
+ */
+static uint32_t
+montysqr(uint16_t *d, const uint16_t *x, const uint16_t *m, uint16_t m0i)
+{
+	size_t len, k, lo, n;
+	uint32_t acc[2], c;
+
+	d[0] = m[0];
+	len = BR_I15_MLEN(m);
+	if (len == 0) {
+		return 0;
+	}
+
+	/*
+	 * Value words are accessed with 1-based indices (x[1] is the
+	 * least significant). c is the carry out of the previous column,
+	 * which is below 2^25.
+	 */
+	c = 0;
+	for (k = 0; k < 2 * len - 1; k ++) {
+		uint32_t z, w;
+
+		/*
+		 * Terms x[i]*x[k-i] with i < k-i, doubled; then the
+		 * square term for even k, and the carry.
+		 */
+		lo = (k < len) ? 0 : k - len + 1;
+		acc[0] = 0;
+		acc[1] = 0;
+		br_i15_dot_column(acc, x + 1 + lo, x + 1 + k - lo,
+			((k + 1) >> 1) - lo);
+		acc[1] = (acc[1] << 1) | (acc[0] >> 31);
+		acc[0] <<= 1;
+		z = c;
+		if ((k & 1) == 0) {
+			w = x[1 + (k >> 1)];
+			z += MUL15(w, w);
+		}
+		acc[0] += z;
+		acc[1] += (acc[0] < z);
+
+		/*
+		 * Reduction terms f[j]*m[k-j]. Below column len, the
+		 * factor of this column is computed last, from the low
+		 * word, which its product then clears.
+		 */
+		if (k < len) {
+			uint32_t f;
+
+			br_i15_dot_column(acc, d + 1, m + 1 + k, k);
+			f = MUL15(acc[0] & 0x7FFF, m0i) & 0x7FFF;
+			d[1 + k] = f;
+			z = MUL15(f, m[1]);
+			acc[0] += z;
+			acc[1] += (acc[0] < z);
+		} else {
+			n = 2 * len - 1 - k;
+			br_i15_dot_column(acc, d + 1 + lo, m + 1 + k - lo, n);
+			d[k - len + 1] = acc[0] & 0x7FFF;
+		}
+		c = (acc[0] >> 15) | (acc[1] << 17);
+	}
+	d[len] = c & 0x7FFF;
+	return c >> 15;
+}
+
+/* see inner.h */
+void
+br_i15_montysqr(uint16_t *d, const uint16_t *x,
+	const uint16_t *m, uint16_t m0i)
+{
+	uint32_t dh;
+
+	/*
+	 * As with br_i15_montymul(), d[] is below twice the modulus.
+	 */
+	dh = montysqr(d, x, m, m0i);
+	BR_I15_SUB(d, m, NEQ(dh, 0) | NOT(BR_I15_SUB(d, m, 0)));
+}
+
+/* see inner.h */
+void
+br_i15_montysqr_lazy(uint16_t *d, const uint16_t *x,
+	const uint16_t *m, uint16_t m0i)
+{
+	(void)montysqr(d, x, m, m0i);
+}
@@ -168,6 +168,6 @@ br_i15_muladd_small(uint16_t *x, uint16_t z, const uint16_t *m)
 	 */
 	over = GT(cc, hi);
 	under = ~over & (tb | LT(cc, hi));
-	br_i15_add(x, m, over);
-	br_i15_sub(x, m, under);
+	BR_I15_ADD(x, m, over);
+	BR_I15_SUB(x, m, under);
 }
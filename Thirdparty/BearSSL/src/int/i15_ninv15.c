@@ -25,7 +25,7 @@
 #include "inner.h"
 
 /* see inner.h */
-uint16_t __attribute__((section(".ovl_rsa")))
+uint16_t
 br_i15_ninv15(uint16_t x)
 {
 	uint32_t y;
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * Montgomery squarings in the chain. Each one halves the shifting that
+ * is left to do; below a few hundred bits, a squaring costs more than
+ * the word shifts it saves.
+ */
+#define RSQ_SQUARINGS   2
+
+/*
+ * d <- 2*d mod m, for d < m.
+ */
+static void
+dbl_mod(uint16_t *d, const uint16_t *m)
+{
+	size_t len, u;
+	uint32_t cc;
+
+	len = (m[0] + 15) >> 4;
+	cc = 0;
+	for (u = 1; u <= len; u ++) {
+		uint32_t w;
+
+		w = ((uint32_t)d[u] << 1) | cc;
+		cc = w >> 15;
+		d[u] = w & 0x7FFF;
+	}
+	BR_I15_SUB(d, m, cc | NOT(BR_I15_SUB(d, m, 0)));
+}
+
+/* see inner.h */
+void
+br_i15_rsquare(uint16_t *d, const uint16_t *m, uint16_t m0i, uint16_t *t)
+{
+	size_t len;
+	uint32_t e, bitlen, n;
+	uint16_t *a, *b, *tt;
+	int i;
+
+	/*
+	 * With a = 2^j*R mod m (the Montgomery form of 2^j), a Montgomery
+	 * squaring gives 2^(2j)*R and a doubling 2^(j+1)*R. R^2 is 2^e*R
+	 * with e = 15*len.
+	 *
+	 * The chain starts at j = e >> RSQ_SQUARINGS, reached by shifting
+	 * 2^(bitlen-1), which is below m, left by j + e - bitlen + 1
+	 * bits: br_i15_muladd_small() shifts by a whole word at a time,
+	 * and doublings do the rest. This replaces the two rounds of
+	 * br_i15_to_monty() (2*len word shifts) with about len/2 word
+	 * shifts and RSQ_SQUARINGS squarings.
+	 */
+	len = (m[0] + 15) >> 4;
+	br_i15_zero(d, m[0]);
+	if (len == 0) {
+		return;
+	}
+	bitlen = 15 * (uint32_t)(m[0] >> 4) + (m[0] & 15);
+	e = 15 * (uint32_t)len;
+	d[1 + ((m[0] - 1) >> 4)] = 1 << ((m[0] - 1) & 15);
+	n = (e >> RSQ_SQUARINGS) + e - bitlen + 1;
+	for (; n >= 15; n -= 15) {
+		br_i15_muladd_small(d, 0, m);
+	}
+	for (; n > 0; n --) {
+		dbl_mod(d, m);
+	}
+
+	a = d;
+	b = t;
+	b[0] = m[0];
+	for (i = RSQ_SQUARINGS - 1; i >= 0; i --) {
+		br_i15_montysqr(b, a, m, m0i);
+		tt = a;
+		a = b;
+		b = tt;
+		if ((e >> i) & 1) {
+			dbl_mod(a, m);
+		}
+	}
+	if (a != d) {
+		memcpy(d, a, (len + 1) * sizeof *d);
+	}
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * SWAR ("SIMD within a register") versions of the i15 primitives: two
+ * 15-bit words go through each 32-bit operation. In add and sub, the
+ * unused top bit of the low half absorbs its carry or borrow, which
+ * the 32-bit operation then propagates into the high half; bit 31
+ * gives the carry or borrow out of the pair.
+ *
+ * Pairs are read from 32-bit aligned addresses only, and only when
+ * all arrays involved share the same alignment; a leading or trailing
+ * odd word, or misaligned arrays, go one word at a time. Alignment is
+ * not secret, so none of this breaks constant-time behaviour.
+ */
+
+/* see inner.h */
+void
+br_i15_zero_swar(uint16_t *x, uint16_t bit_len)
+{
+	size_t len;
+
+	*x ++ = bit_len;
+	len = (bit_len + 15) >> 4;
+	if (len > 0 && ((uintptr_t)x & 2) != 0) {
+		*x ++ = 0;
+		len --;
+	}
+	while (len >= 2) {
+		*(br_swar32 *)x = 0;
+		x += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		*x = 0;
+	}
+}
+
+/* see inner.h */
+uint32_t
+br_i15_add_swar(uint16_t *a, const uint16_t *b, uint32_t ctl)
+{
+	uint32_t cc, mask;
+	size_t u, m;
+
+	cc = 0;
+	mask = -ctl;
+	m = (a[0] + 31) >> 4;
+	u = 1;
+	if ((((uintptr_t)a ^ (uintptr_t)b) & 2) == 0) {
+		if (u < m && ((uintptr_t)(a + u) & 2) != 0) {
+			uint32_t aw, naw;
+
+			aw = a[u];
+			naw = aw + b[u];
+			cc = naw >> 15;
+			a[u] = aw ^ (mask & (aw ^ (naw & 0x7FFF)));
+			u ++;
+		}
+		for (; u + 1 < m; u += 2) {
+			uint32_t aw, naw;
+
+			aw = *(br_swar32 *)(a + u);
+			naw = aw + *(const br_swar32 *)(b + u) + cc + 0x8000;
+			cc = naw >> 31;
+			naw &= 0x7FFF7FFF;
+			*(br_swar32 *)(a + u) = aw ^ (mask & (aw ^ naw));
+		}
+	}
+	for (; u < m; u ++) {
+		uint32_t aw, naw;
+
+		aw = a[u];
+		naw = aw + b[u] + cc;
+		cc = naw >> 15;
+		a[u] = aw ^ (mask & (aw ^ (naw & 0x7FFF)));
+	}
+	return cc;
+}
+
+/* see inner.h */
+uint32_t
+br_i15_sub_swar(uint16_t *a, const uint16_t *b, uint32_t ctl)
+{
+	uint32_t cc, mask;
+	size_t u, m;
+
+	cc = 0;
+	mask = -ctl;
+	m = (a[0] + 31) >> 4;
+	u = 1;
+	if ((((uintptr_t)a ^ (uintptr_t)b) & 2) == 0) {
+		if (u < m && ((uintptr_t)(a + u) & 2) != 0) {
+			uint32_t aw, naw;
+
+			aw = a[u];
+			naw = aw - b[u];
+			cc = naw >> 31;
+			a[u] = aw ^ (mask & (aw ^ (naw & 0x7FFF)));
+			u ++;
+		}
+		for (; u + 1 < m; u += 2) {
+			uint32_t aw, naw;
+
+			aw = *(br_swar32 *)(a + u);
+			naw = aw - *(const br_swar32 *)(b + u) - cc;
+			cc = naw >> 31;
+			naw &= 0x7FFF7FFF;
+			*(br_swar32 *)(a + u) = aw ^ (mask & (aw ^ naw));
+		}
+	}
+	for (; u < m; u ++) {
+		uint32_t aw, naw;
+
+		aw = a[u];
+		naw = aw - b[u] - cc;
+		cc = naw >> 31;
+		a[u] = aw ^ (mask & (aw ^ (naw & 0x7FFF)));
+	}
+	return cc;
+}
+
+/*
+ * Lookup of words u in [from, to) of the entries, one word at a time.
+ */
+static void
+lookup_words(uint16_t *d, const uint16_t *tab, size_t mwlen,
+	uint32_t num, uint32_t idx, size_t from, size_t to)
+{
+	size_t u;
+	uint32_t k;
+
+	for (u = from; u < to; u ++) {
+		uint32_t w;
+
+		w = 0;
+		for (k = 1; k < num; k ++) {
+			w |= -EQ(k, idx) & tab[(k - 1) * mwlen + u];
+		}
+		d[u] = w;
+	}
+}
+
+/* see inner.h */
+void
+br_i15_lookup_swar(uint16_t *d, const uint16_t *tab, size_t mwlen,
+	uint32_t num, uint32_t idx)
+{
+	size_t u, v, end;
+	uint32_t k;
+
+	/*
+	 * Entries are mwlen words apart; with an even mwlen and tab[]
+	 * aligned like d[], the words of a given index pair up in all of
+	 * them. Words [v, end) are done by pairs.
+	 */
+	if (mwlen < 2 || (mwlen & 1) != 0
+		|| (((uintptr_t)d ^ (uintptr_t)tab) & 2) != 0)
+	{
+		lookup_words(d, tab, mwlen, num, idx, 1, mwlen);
+		return;
+	}
+	v = 1 + (((uintptr_t)(d + 1) & 2) >> 1);
+	end = v + ((mwlen - v) & ~(size_t)1);
+	for (u = v; u < end; u += 2) {
+		*(br_swar32 *)(d + u) = 0;
+	}
+	for (k = 1; k < num; k ++) {
+		const uint16_t *e;
+		uint32_t mask;
+
+		e = tab + (k - 1) * mwlen;
+		mask = -EQ(k, idx);
+		for (u = v; u < end; u += 2) {
+			*(br_swar32 *)(d + u) |= mask & *(const br_swar32 *)(e + u);
+		}
+	}
+	lookup_words(d, tab, mwlen, num, idx, 1, v);
+	lookup_words(d, tab, mwlen, num, idx, end, mwlen);
+}
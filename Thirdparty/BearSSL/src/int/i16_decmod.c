@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/* see inner.h */
+uint32_t
+br_i16_decode_mod(uint16_t *x, const void *src, size_t len, const uint16_t *m)
+{
+	/*
+	 * Same two-pass algorithm as br_i15_decode_mod(): the first pass
+	 * compares the value with the modulus, the second writes it (or
+	 * zeros if it does not fit). Words are whole byte pairs, read
+	 * from the end of src[]; missing bytes are zeros.
+	 *
+	 * During the first pass, 'r' is 0 (equal so far), 1 (greater)
+	 * or 0xFFFFFFFF (lower); in the second, 0xFFFFFFFF or 0.
+	 */
+	const unsigned char *buf;
+	size_t mlen, tlen;
+	int pass;
+	uint32_t r;
+
+	buf = src;
+	mlen = (m[0] + 15) >> 4;
+	tlen = (len + 1) >> 1;
+	if (tlen < mlen) {
+		tlen = mlen;
+	}
+	r = 0;
+	for (pass = 0; pass < 2; pass ++) {
+		size_t v;
+
+		for (v = 1; v <= tlen; v ++) {
+			uint32_t xw;
+			size_t u;
+
+			u = (v - 1) << 1;
+			xw = 0;
+			if (u < len) {
+				xw = buf[len - 1 - u];
+			}
+			if (u + 1 < len) {
+				xw |= (uint32_t)buf[len - 2 - u] << 8;
+			}
+			if (v <= mlen) {
+				if (pass) {
+					x[v] = r & xw;
+				} else {
+					uint32_t cc;
+
+					cc = (uint32_t)CMP(xw, m[v]);
+					r = MUX(EQ(cc, 0), r, cc);
+				}
+			} else {
+				if (!pass) {
+					r = MUX(EQ(xw, 0), r, 1);
+				}
+			}
+		}
+
+		/*
+		 * Map 0 and 1 to 0, and keep 0xFFFFFFFF (see
+		 * br_i15_decode_mod()).
+		 */
+		r >>= 1;
+		r |= (r << 1);
+	}
+
+	x[0] = m[0];
+	return r & (uint32_t)1;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/* see inner.h */
+void
+br_i16_modpow_vartime(uint16_t *x, const unsigned char *e, size_t elen,
+	const uint16_t *m, uint16_t m0i, const uint16_t *r2,
+	uint16_t *t1, uint16_t *t2)
+{
+	size_t mlen, u;
+	uint16_t *base, *acc, *spare, *tt;
+	uint32_t ev;
+	int k;
+
+	mlen = ((m[0] + 31) >> 4) * sizeof m[0];
+
+	/*
+	 * Skip leading zeros; x^0 = 1 and x^1 = x need no work.
+	 */
+	while (elen > 0 && *e == 0) {
+		e ++;
+		elen --;
+	}
+	if (elen == 0) {
+		br_i16_zero(x, m[0]);
+		x[1] = 1;
+		return;
+	}
+	if (elen == 1 && *e == 1) {
+		return;
+	}
+
+	/*
+	 * Same buffer rotation as br_i15_modpow_vartime(). Without R^2
+	 * at hand, it is computed into t2 first (t1 as scratch), and t2
+	 * is free again once x is in Montgomery form.
+	 */
+	if (r2 == NULL) {
+		br_i16_rsquare(t2, m, m0i, t1);
+		r2 = t2;
+	}
+	br_i16_montymul(t1, x, r2, m, m0i);
+	base = t1;
+	spare = x;
+	acc = base;
+
+	/*
+	 * Exponents of the form 2^k+1 (3, 17, 65537) are a fixed chain:
+	 * k squarings and one multiplication by x.
+	 */
+	ev = 0;
+	if (elen <= 3) {
+		for (u = 0; u < elen; u ++) {
+			ev = (ev << 8) | e[u];
+		}
+	}
+	if (ev > 2 && ((ev - 1) & (ev - 2)) == 0) {
+		for (k = 0; ((ev - 1) >> k) > 1; k ++) {
+			br_i16_montymul(spare, acc, acc, m, m0i);
+			tt = acc;
+			acc = spare;
+			spare = (tt == base) ? t2 : tt;
+		}
+		br_i16_montymul(spare, acc, base, m, m0i);
+		acc = spare;
+	} else {
+		uint32_t bit;
+
+		bit = 0x80;
+		while ((*e & bit) == 0) {
+			bit >>= 1;
+		}
+		for (;;) {
+			bit >>= 1;
+			if (bit == 0) {
+				if (-- elen == 0) {
+					break;
+				}
+				e ++;
+				bit = 0x80;
+			}
+			br_i16_montymul(spare, acc, acc, m, m0i);
+			tt = acc;
+			acc = spare;
+			spare = (tt == base) ? t2 : tt;
+			if (*e & bit) {
+				br_i16_montymul(spare, acc, base, m, m0i);
+				tt = acc;
+				acc = spare;
+				spare = tt;
+			}
+		}
+	}
+
+	/*
+	 * Convert back from Montgomery representation.
+	 */
+	br_i16_from_monty(acc, m, m0i);
+	if (acc != x) {
+		memcpy(x, acc, mlen);
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * Product-scanning Montgomery multiplication, as in i15_montcol.c: with
+ * 16-bit words, a row loop would need two carries per step (each
+ * d + x*y + carry only just fits in 32 bits), while a column sum only
+ * needs a 64-bit accumulator, which br_i16_dot_column() keeps in
+ * registers. The Montgomery factors are kept in d[], which therefore
+ * must not overlap x[], y[] or m[].
+ */
+
+/* see inner.h */
+void
+br_i16_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+	const uint16_t *m, uint16_t m0i)
+{
+	size_t len, k, lo, n;
+	uint32_t acc[2], c, dh;
+
+	len = (m[0] + 15) >> 4;
+	if (len == 0) {
+		d[0] = m[0];
+		return;
+	}
+
+	/*
+	 * Value words are accessed with 1-based indices. A column holds
+	 * at most 2*len products below 2^32, so the carry c into the
+	 * next one stays below 2^(17+log2(len)).
+	 */
+	c = 0;
+	for (k = 0; k < 2 * len - 1; k ++) {
+		lo = (k < len) ? 0 : k - len + 1;
+		n = (k < len) ? k + 1 : 2 * len - 1 - k;
+		acc[0] = c;
+		acc[1] = 0;
+		br_i16_dot_column(acc, x + 1 + lo, y + 1 + k - lo, n);
+		if (k < len) {
+			uint32_t f, z;
+
+			br_i16_dot_column(acc, d + 1, m + 1 + k, k);
+			f = (acc[0] * (uint32_t)m0i) & 0xFFFF;
+			d[1 + k] = f;
+			z = f * (uint32_t)m[1];
+			acc[0] += z;
+			acc[1] += (acc[0] < z);
+		} else {
+			br_i16_dot_column(acc, d + 1 + lo, m + 1 + k - lo, n);
+			d[k - len + 1] = acc[0] & 0xFFFF;
+		}
+		c = (acc[0] >> 16) | (acc[1] << 16);
+	}
+	d[len] = c & 0xFFFF;
+	dh = c >> 16;
+
+	/*
+	 * d[] may be greater than m[], but it is still lower than twice
+	 * the modulus.
+	 */
+	d[0] = m[0];
+	br_i16_sub(d, m, NEQ(dh, 0) | NOT(br_i16_sub(d, m, 0)));
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * d <- 2*d mod m, for d < m.
+ */
+static void
+dbl_mod(uint16_t *d, const uint16_t *m)
+{
+	size_t len, u;
+	uint32_t cc;
+
+	len = (m[0] + 15) >> 4;
+	cc = 0;
+	for (u = 1; u <= len; u ++) {
+		uint32_t w;
+
+		w = ((uint32_t)d[u] << 1) | cc;
+		cc = w >> 16;
+		d[u] = w & 0xFFFF;
+	}
+	br_i16_sub(d, m, cc | NOT(br_i16_sub(d, m, 0)));
+}
+
+/* see inner.h */
+void
+br_i16_rsquare(uint16_t *d, const uint16_t *m, uint16_t m0i, uint16_t *t)
+{
+	size_t len, u;
+	uint32_t e, bits;
+	uint16_t *a, *b, *tt;
+	int i;
+
+	/*
+	 * With a = 2^j*R mod m (the Montgomery form of 2^j), a Montgomery
+	 * squaring gives 2^(2j)*R and a doubling 2^(j+1)*R. R^2 is
+	 * 2^e*R with e = 16*len, reached from j = 1 by the bits of e:
+	 * about log2(e) products instead of e shifts.
+	 *
+	 * The start value 2R mod m is 2^(bitlen-1), below m since m is
+	 * odd, doubled 16*len - bitlen + 2 times.
+	 */
+	len = (m[0] + 15) >> 4;
+	br_i16_zero(d, m[0]);
+	if (len == 0) {
+		return;
+	}
+	d[1 + ((m[0] - 1) >> 4)] = 1 << ((m[0] - 1) & 15);
+	for (u = (len << 4) - m[0] + 2; u > 0; u --) {
+		dbl_mod(d, m);
+	}
+
+	e = (uint32_t)len << 4;
+	for (bits = 0; (e >> bits) > 1; bits ++);
+	a = d;
+	b = t;
+	b[0] = m[0];
+	for (i = (int)bits - 1; i >= 0; i --) {
+		br_i16_montymul(b, a, a, m, m0i);
+		tt = a;
+		a = b;
+		b = tt;
+		if ((e >> i) & 1) {
+			dbl_mod(a, m);
+		}
+	}
+	if (a != d) {
+		memcpy(d, a, (len + 1) * sizeof *d);
+	}
+}
@@ -26,48 +26,27 @@
 
 /*
  * As a strict minimum, we need four buffers that can hold a
- * modular integer.
+ * modular integer; with kernels built for one size, of that size.
  */
+#if BR_I15_FIXED_BITS
+#define TLEN   (4 * (2 + BR_I15_FIXED_LEN))
+#else
 #define TLEN   (4 * (2 + ((BR_MAX_RSA_SIZE + 14) / 15)))
+#endif
 
-/* see bearssl_rsa.h */
-uint32_t __attribute__((section(".ovl_rsa")))
-br_rsa_i15_public(unsigned char *x, size_t xlen,
-	const br_rsa_public_key *pk)
+/*
+ * Exponentiate x[] modulo n[] (nlen bytes, no leading zero, fwlen words
+ * once decoded), with 1 + 4 * fwlen words of temporaries in tmp[].
+ */
+static uint32_t
+rsa_i15_modexp(unsigned char *x, size_t xlen,
+	const unsigned char *n, size_t nlen, const br_rsa_public_key *pk,
+	size_t fwlen, uint16_t *tmp)
 {
-	const unsigned char *n;
-	size_t nlen;
-	uint16_t tmp[1 + TLEN];
 	uint16_t *m, *a, *t;
-	size_t fwlen;
-	long z;
 	uint16_t m0i;
 	uint32_t r;
 
-	/*
-	 * Get the actual length of the modulus, and see if it fits within
-	 * our stack buffer. We also check that the length of x[] is valid.
-	 */
-	n = pk->n;
-	nlen = pk->nlen;
-	while (nlen > 0 && *n == 0) {
-		n ++;
-		nlen --;
-	}
-	if (nlen == 0 || nlen > (BR_MAX_RSA_SIZE >> 3) || xlen != nlen) {
-		return 0;
-	}
-	z = (long)nlen << 3;
-	fwlen = 1;
-	while (z > 0) {
-		z -= 15;
-		fwlen ++;
-	}
-	/*
-	 * Round up length to an even number.
-	 */
-	fwlen += (fwlen & 1);
-
 	/*
 	 * The modulus gets decoded into m[].
 	 * The value to exponentiate goes into a[].
@@ -101,9 +80,11 @@ br_rsa_i15_public(unsigned char *x, size_t xlen,
 	r &= br_i15_decode_mod(a, x, xlen, m);
 
 	/*
-	 * Compute the modular exponentiation.
+	 * Compute the modular exponentiation. The exponent is public, so
+	 * the variable-time path applies: it needs no window table, and
+	 * 65537 costs 16 squarings and a single multiplication.
 	 */
-	br_i15_modpow_opt(a, pk->e, pk->elen, m, m0i, t, TLEN - 2 * fwlen);
+	br_i15_modpow_vartime(a, pk->e, pk->elen, m, m0i, NULL, t, t + fwlen);
 
 	/*
 	 * Encode the result.
@@ -111,3 +92,128 @@ br_rsa_i15_public(unsigned char *x, size_t xlen,
 	br_i15_encode(x, xlen, a);
 	return r;
 }
+
+/*
+ * Temporaries on the stack. When the application may lend them
+ * (BR_SCRATCH_ACQUIRE), this is the fallback and is kept out of line,
+ * so that the stack only grows when it is actually needed.
+ */
+#if defined BR_SCRATCH_ACQUIRE && (BR_GCC || BR_CLANG)
+__attribute__((noinline))
+#endif
+static uint32_t
+rsa_i15_modexp_stack(unsigned char *x, size_t xlen,
+	const unsigned char *n, size_t nlen, const br_rsa_public_key *pk,
+	size_t fwlen)
+{
+	uint16_t tmp[1 + TLEN];
+
+	return rsa_i15_modexp(x, xlen, n, nlen, pk, fwlen, tmp);
+}
+
+/*
+ * Strip the leading zeros of the modulus and return the length of its
+ * decoded form (header word included, rounded up to an even number of
+ * words), or 0 if the key is not supported.
+ */
+static size_t
+rsa_i15_key_len(const br_rsa_public_key *pk,
+	const unsigned char **np, size_t *nlenp)
+{
+	const unsigned char *n;
+	size_t nlen, fwlen;
+
+	n = pk->n;
+	nlen = pk->nlen;
+	while (nlen > 0 && *n == 0) {
+		n ++;
+		nlen --;
+	}
+	if (nlen == 0 || nlen > (BR_MAX_RSA_SIZE >> 3)) {
+		return 0;
+	}
+	*np = n;
+	*nlenp = nlen;
+
+	/*
+	 * Value words for the exact bit length, as br_i15_decode()
+	 * produces them.
+	 */
+	fwlen = ((((nlen - 1) << 3) + BIT_LENGTH(n[0]) + 14) / 15);
+#if BR_I15_FIXED_BITS
+	if (fwlen != BR_I15_FIXED_LEN) {
+		return 0;
+	}
+#endif
+	fwlen ++;
+	return fwlen + (fwlen & 1);
+}
+
+/* see bearssl_rsa.h */
+size_t
+br_rsa_i15_public_ws_len(const br_rsa_public_key *pk)
+{
+	const unsigned char *n;
+	size_t nlen, fwlen;
+
+	fwlen = rsa_i15_key_len(pk, &n, &nlen);
+	if (fwlen == 0) {
+		return 0;
+	}
+	return (1 + 4 * fwlen) * sizeof(uint16_t);
+}
+
+/* see bearssl_rsa.h */
+uint32_t
+br_rsa_i15_public_ws(unsigned char *x, size_t xlen,
+	const br_rsa_public_key *pk, void *ws, size_t ws_len)
+{
+	const unsigned char *n;
+	size_t nlen, fwlen;
+
+	fwlen = rsa_i15_key_len(pk, &n, &nlen);
+	if (fwlen == 0 || xlen != nlen
+		|| ws_len < (1 + 4 * fwlen) * sizeof(uint16_t))
+	{
+		return 0;
+	}
+	return rsa_i15_modexp(x, xlen, n, nlen, pk, fwlen, ws);
+}
+
+/* see bearssl_rsa.h */
+uint32_t
+br_rsa_i15_public(unsigned char *x, size_t xlen,
+	const br_rsa_public_key *pk)
+{
+	const unsigned char *n;
+	size_t nlen, fwlen;
+
+	/*
+	 * Get the actual length of the modulus, and see if it fits within
+	 * our stack buffer. We also check that the length of x[] is valid.
+	 */
+	fwlen = rsa_i15_key_len(pk, &n, &nlen);
+	if (fwlen == 0 || xlen != nlen) {
+		return 0;
+	}
+
+#ifdef BR_SCRATCH_ACQUIRE
+	{
+		void *ws;
+		size_t wlen;
+		uint32_t r;
+
+		/*
+		 * Borrow the temporaries when the application has memory
+		 * to lend.
+		 */
+		ws = BR_SCRATCH_ACQUIRE((1 + 4 * fwlen) * sizeof(uint16_t), &wlen);
+		if (ws != NULL) {
+			r = rsa_i15_modexp(x, xlen, n, nlen, pk, fwlen, ws);
+			BR_SCRATCH_RELEASE();
+			return r;
+		}
+	}
+#endif
+	return rsa_i15_modexp_stack(x, xlen, n, nlen, pk, fwlen);
+}
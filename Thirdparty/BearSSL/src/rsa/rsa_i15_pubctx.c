@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * Operand and two temporaries for the exponentiation, plus one word for
+ * alignment; the modulus and R^2 come from the context.
+ */
+#define TLEN   (1 + 3 * BR_RSA_I15_PUBCTX_WORDS)
+
+/* see bearssl_rsa.h */
+uint32_t
+br_rsa_i15_pubctx_init(br_rsa_i15_pubctx *ctx, const br_rsa_public_key *pk)
+{
+	const unsigned char *n;
+	size_t nlen;
+	uint16_t *m;
+	uint16_t t[BR_RSA_I15_PUBCTX_WORDS];
+
+	n = pk->n;
+	nlen = pk->nlen;
+	while (nlen > 0 && *n == 0) {
+		n ++;
+		nlen --;
+	}
+	if (nlen == 0 || nlen > (BR_MAX_RSA_SIZE >> 3)
+		|| nlen > (BR_RSA_I15_PUBCTX_MAX_BITS >> 3)
+		|| (n[nlen - 1] & 1) == 0)
+	{
+		return 0;
+	}
+#if BR_I15_FIXED_BITS
+	if (((((nlen - 1) << 3) + BIT_LENGTH(n[0]) + 14) / 15)
+		!= BR_I15_FIXED_LEN)
+	{
+		return 0;
+	}
+#endif
+	m = ctx->m;
+	br_i15_decode(m, n, nlen);
+	ctx->m0i = br_i15_ninv15(m[1]);
+	ctx->nlen = nlen;
+	ctx->e = pk->e;
+	ctx->elen = pk->elen;
+
+	/*
+	 * R^2 mod N, through a short chain of Montgomery squarings
+	 * rather than by converting 1 to Montgomery representation twice.
+	 */
+	br_i15_rsquare(ctx->r2, m, ctx->m0i, t);
+	return 1;
+}
+
+/*
+ * Exponentiate each of xs[0..n-1] (ctx->nlen bytes) in place, with
+ * 1 + 3 * fwlen words of temporaries in tmp[], which must be 32-bit
+ * aligned. The outcome of each is written to results[] when not NULL;
+ * the number of successes is returned.
+ */
+static size_t
+rsa_i15_ctx_modexp(unsigned char *const *xs, size_t n, uint32_t *results,
+	const br_rsa_i15_pubctx *ctx, size_t fwlen, uint16_t *tmp)
+{
+	uint16_t *a, *t;
+	size_t u, good;
+
+	/*
+	 * Keep the first value word of a[] and t[] 32-bit aligned, as
+	 * those of the context are.
+	 */
+	a = tmp + 1;
+	t = a + fwlen;
+
+	good = 0;
+	for (u = 0; u < n; u ++) {
+		uint32_t r;
+
+		r = br_i15_decode_mod(a, xs[u], ctx->nlen, ctx->m);
+		br_i15_modpow_vartime(a, ctx->e, ctx->elen, ctx->m, ctx->m0i,
+			ctx->r2, t, t + fwlen);
+		br_i15_encode(xs[u], ctx->nlen, a);
+		if (results != NULL) {
+			results[u] = r;
+		}
+		good += r;
+	}
+	return good;
+}
+
+/*
+ * Temporaries on the stack; out of line when they may be borrowed
+ * instead (see rsa_i15_pub.c).
+ */
+#if defined BR_SCRATCH_ACQUIRE && (BR_GCC || BR_CLANG)
+__attribute__((noinline))
+#endif
+static size_t
+rsa_i15_ctx_modexp_stack(unsigned char *const *xs, size_t n,
+	uint32_t *results, const br_rsa_i15_pubctx *ctx, size_t fwlen)
+{
+	uint32_t tmp[(TLEN + 1) >> 1];
+
+	return rsa_i15_ctx_modexp(xs, n, results, ctx, fwlen, (uint16_t *)tmp);
+}
+
+/* see bearssl_rsa.h */
+size_t
+br_rsa_i15_public_batch(const br_rsa_i15_pubctx *ctx,
+	unsigned char *const *sigs, size_t n, uint32_t *results)
+{
+	size_t fwlen;
+
+	/*
+	 * Same length as the decoded modulus, rounded up to an even
+	 * number of words.
+	 */
+	fwlen = ((ctx->m[0] + 31) >> 4);
+	fwlen += (fwlen & 1);
+
+#ifdef BR_SCRATCH_ACQUIRE
+	{
+		void *ws;
+		size_t wlen, good;
+
+		/*
+		 * One workspace for the whole batch.
+		 */
+		ws = BR_SCRATCH_ACQUIRE((1 + 3 * fwlen) * sizeof(uint16_t), &wlen);
+		if (ws != NULL) {
+			good = rsa_i15_ctx_modexp(sigs, n, results, ctx, fwlen, ws);
+			BR_SCRATCH_RELEASE();
+			return good;
+		}
+	}
+#endif
+	return rsa_i15_ctx_modexp_stack(sigs, n, results, ctx, fwlen);
+}
+
+/* see bearssl_rsa.h */
+uint32_t
+br_rsa_i15_public_ctx(unsigned char *x, size_t xlen,
+	const br_rsa_i15_pubctx *ctx)
+{
+	if (xlen != ctx->nlen) {
+		return 0;
+	}
+	return (uint32_t)br_rsa_i15_public_batch(ctx, &x, 1, NULL);
+}
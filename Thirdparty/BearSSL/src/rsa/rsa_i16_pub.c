@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2025 Jacen Li
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining 
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be 
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "inner.h"
+
+/*
+ * Four buffers that can hold a modular integer, as in rsa_i15_pub.c,
+ * of 16-bit words this time.
+ */
+#define TLEN   (4 * (2 + ((BR_MAX_RSA_SIZE + 15) / 16)))
+
+/*
+ * Exponentiate x[] modulo n[] (nlen bytes, no leading zero, fwlen words
+ * once decoded), with 1 + 4 * fwlen words of temporaries in tmp[].
+ */
+static uint32_t
+rsa_i16_modexp(unsigned char *x, size_t xlen,
+	const unsigned char *n, size_t nlen, const br_rsa_public_key *pk,
+	size_t fwlen, uint16_t *tmp)
+{
+	uint16_t *m, *a, *t;
+	uint16_t m0i;
+	uint32_t r;
+
+	/*
+	 * Modulus in m[], value in a[], exponentiation temporaries in
+	 * t[], with the first value word of each on a 32-bit boundary.
+	 */
+	m = tmp;
+	if (((uintptr_t)m & 2) == 0) {
+		m ++;
+	}
+	a = m + fwlen;
+	t = m + 2 * fwlen;
+
+	br_i16_decode(m, n, nlen);
+	m0i = br_i16_ninv16(m[1]);
+
+	/*
+	 * Note: if m[] is even, then m0i == 0. Otherwise, m0i must be
+	 * an odd integer.
+	 */
+	r = m0i & 1;
+
+	r &= br_i16_decode_mod(a, x, xlen, m);
+	br_i16_modpow_vartime(a, pk->e, pk->elen, m, m0i, NULL, t, t + fwlen);
+	br_i16_encode(x, xlen, a);
+	return r;
+}
+
+/*
+ * Temporaries on the stack, out of line when BR_SCRATCH_ACQUIRE may
+ * lend them (see rsa_i15_pub.c).
+ */
+#if defined BR_SCRATCH_ACQUIRE && (BR_GCC || BR_CLANG)
+__attribute__((noinline))
+#endif
+static uint32_t
+rsa_i16_modexp_stack(unsigned char *x, size_t xlen,
+	const unsigned char *n, size_t nlen, const br_rsa_public_key *pk,
+	size_t fwlen)
+{
+	uint16_t tmp[1 + TLEN];
+
+	return rsa_i16_modexp(x, xlen, n, nlen, pk, fwlen, tmp);
+}
+
+/* see bearssl_rsa.h */
+uint32_t
+br_rsa_i16_public(unsigned char *x, size_t xlen,
+	const br_rsa_public_key *pk)
+{
+	const unsigned char *n;
+	size_t nlen;
+	size_t fwlen;
+
+	n = pk->n;
+	nlen = pk->nlen;
+	while (nlen > 0 && *n == 0) {
+		n ++;
+		nlen --;
+	}
+	if (nlen == 0 || nlen > (BR_MAX_RSA_SIZE >> 3) || xlen != nlen) {
+		return 0;
+	}
+
+	/*
+	 * Header word and one word per two bytes, rounded up to an even
+	 * number.
+	 */
+	fwlen = 1 + ((nlen + 1) >> 1);
+	fwlen += (fwlen & 1);
+
+#ifdef BR_SCRATCH_ACQUIRE
+	{
+		void *ws;
+		size_t wlen;
+		uint32_t r;
+
+		ws = BR_SCRATCH_ACQUIRE((1 + 4 * fwlen) * sizeof(uint16_t), &wlen);
+		if (ws != NULL) {
+			r = rsa_i16_modexp(x, xlen, n, nlen, pk, fwlen, ws);
+			BR_SCRATCH_RELEASE();
+			return r;
+		}
+	}
+#endif
+	return rsa_i16_modexp_stack(x, xlen, n, nlen, pk, fwlen);
+}
@@ -158,6 +158,23 @@ static const br_config_option config[] = {
 	 0
 #endif
 	},
+	{ "BR_I15_COMBA",
+#if BR_I15_COMBA
+	 1
+#else
+	 0
+#endif
+	},
+	{ "BR_I15_SWAR",
+#if BR_I15_SWAR
+	 1
+#else
+	 0
+#endif
+	},
+#ifdef BR_I15_FIXED_BITS
+	{ "BR_I15_FIXED_BITS", BR_I15_FIXED_BITS },
+#endif
 	{ "BR_INT128",
 #if BR_INT128
 	 1
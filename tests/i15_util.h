@@ -0,0 +1,120 @@
+#ifndef I15_UTIL_H
+#define I15_UTIL_H
+
+#include <string.h>
+
+#include "inner.h"
+#include "ovl_fake_port.h"
+
+/*============================================================================
+ * I15 DIFFERENTIAL TEST HELPERS
+ *============================================================================*/
+
+/*
+ * The BearSSL code under test is built with the firmware's options
+ * (BR_I15_COMBA, BR_I15_SWAR, BR_I15_FIXED_BITS, the scratch hooks).
+ * The reference is the same i15 sources built with none of them, with
+ * every global renamed ref_* (see the Makefile): row-by-row montymul,
+ * plain zero/add/sub/ccopy, generic lengths, stack temporaries.
+ */
+void ref_br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y,
+                         const uint16_t *m, uint16_t m0i);
+void ref_br_i15_to_monty(uint16_t *x, const uint16_t *m);
+void ref_br_i15_from_monty(uint16_t *x, const uint16_t *m, uint16_t m0i);
+uint32_t ref_br_i15_decode_mod(uint16_t *x, const void *src, size_t len,
+                               const uint16_t *m);
+void ref_br_i15_decode_reduce(uint16_t *x, const void *src, size_t len,
+                              const uint16_t *m);
+void ref_br_i15_encode(void *dst, size_t len, const uint16_t *x);
+uint16_t ref_br_i15_ninv15(uint16_t x);
+void ref_br_i15_mulacc(uint16_t *d, const uint16_t *a, const uint16_t *b);
+void ref_br_i15_modpow(uint16_t *x, const unsigned char *e, size_t elen,
+                       const uint16_t *m, uint16_t m0i, uint16_t *t1, uint16_t *t2);
+uint32_t ref_br_i15_add(uint16_t *a, const uint16_t *b, uint32_t ctl);
+uint32_t ref_br_i15_sub(uint16_t *a, const uint16_t *b, uint32_t ctl);
+void ref_br_ccopy(uint32_t ctl, void *dst, const void *src, size_t len);
+uint32_t ref_br_rsa_i15_public(unsigned char *x, size_t xlen,
+                               const br_rsa_public_key *pk);
+
+/* Largest modulus the tests use, and i15 buffers that hold it */
+#if BR_I15_FIXED_BITS
+#define I15_TEST_BITS    BR_I15_FIXED_BITS
+#else
+#define I15_TEST_BITS    BR_MAX_RSA_SIZE
+#endif
+#define I15_WORDS        (2 + (I15_TEST_BITS + 14) / 15)
+
+/*
+ * Modulus size for round n: the one size the kernels are built for, or
+ * a spread of sizes (odd ones, and ones with a full top word) otherwise.
+ */
+static inline unsigned i15_test_bits(unsigned n)
+{
+#if BR_I15_FIXED_BITS
+    (void)n;
+    return BR_I15_FIXED_BITS;
+#else
+    static const unsigned bits[] = { I15_TEST_BITS, 1024, 521, 1020, 1500, 255, 17 };
+    return bits[n % (sizeof(bits) / sizeof(bits[0]))];
+#endif
+}
+
+static inline void i15_random_bytes(void *dst, size_t len)
+{
+    uint8_t *p = dst;
+
+    while (len-- > 0) {
+        *p++ = (uint8_t)test_rand();
+    }
+}
+
+/* Random odd modulus of exactly bits bits, big-endian in n[] and in m[] */
+static inline size_t i15_random_mod(uint16_t *m, unsigned char *n, unsigned bits)
+{
+    size_t len = (bits + 7) / 8;
+
+    i15_random_bytes(n, len);
+    n[0] &= (unsigned char)(0xFF >> (8 * len - bits));
+    n[0] |= (unsigned char)(0x80 >> (8 * len - bits));
+    n[len - 1] |= 1;
+    br_i15_decode(m, n, len);
+    return len;
+}
+
+/* Random value modulo m[] */
+static inline void i15_random_below(uint16_t *x, const uint16_t *m)
+{
+    unsigned char buf[I15_TEST_BITS / 8 + 8];
+
+    i15_random_bytes(buf, sizeof(buf));
+    br_i15_decode_reduce(x, buf, sizeof(buf), m);
+}
+
+/* Header and value words of two integers agree */
+static inline int i15_equal(const uint16_t *a, const uint16_t *b)
+{
+    return a[0] == b[0] && memcmp(a + 1, b + 1, ((a[0] + 15) >> 4) * 2) == 0;
+}
+
+/* Non-zero if x < m (both with the same header) */
+static inline int i15_below(const uint16_t *x, const uint16_t *m)
+{
+    for (size_t u = (m[0] + 15) >> 4; u > 0; u--) {
+        if (x[u] != m[u]) {
+            return x[u] < m[u];
+        }
+    }
+    return 0;
+}
+
+/*
+ * Seed the generator and put the overlay manager on an empty table, so
+ * BR_SCRATCH_ACQUIRE lends the whole fake window.
+ */
+static inline void i15_test_init(uint32_t seed)
+{
+    test_rng = seed;
+    ovl_init(fake_table(NULL, 0), fake_window);
+}
+
+#endif /* I15_UTIL_H */
@@ -0,0 +1,47 @@
+#ifndef KEY_UTIL_H
+#define KEY_UTIL_H
+
+#include "i15_util.h"
+#include "rsa_keys.h"
+
+/*============================================================================
+ * KEY TABLE HELPERS
+ *============================================================================*/
+
+/*
+ * The tests that include this link the tables tools/rsakey.py compiles
+ * from data/rsa_priv.pem, with --sign signatures over the pattern
+ * message (see the Makefile).
+ */
+#define KEY_SIG_COUNT  (sizeof(test_key_sig) / sizeof(test_key_sig[0]))
+
+static unsigned char key_n[BR_RSA_I15_PUBCTX_MAX_BITS / 8];
+static br_rsa_public_key key_pk;
+
+/* The public key of the tables in key_pk, the modulus back in bytes */
+static inline void key_init(void)
+{
+    key_pk.nlen = test_key_pub.nlen;
+    ref_br_i15_encode(key_n, key_pk.nlen, test_key_pub.m);
+    key_pk.n = key_n;
+    key_pk.e = (unsigned char *)test_key_pub.e;
+    key_pk.elen = test_key_pub.elen;
+}
+
+/* SHA-256 of the first len bytes of the pattern message (byte i is i & 0xFF) */
+static inline void key_pattern_hash(unsigned char *out, size_t len)
+{
+    unsigned char buf[256];
+    br_sha256_context sc;
+
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (unsigned char)i;
+    }
+    br_sha256_init(&sc);
+    for (size_t off = 0; off < len; off += sizeof(buf)) {
+        br_sha256_update(&sc, buf, len - off < sizeof(buf) ? len - off : sizeof(buf));
+    }
+    br_sha256_out(&sc, out);
+}
+
+#endif /* KEY_UTIL_H */
@@ -0,0 +1,195 @@
+#include <string.h>
+
+#include "ovl_fake_port.h"
+
+/*============================================================================
+ * FAKE MEMORY
+ *============================================================================*/
+
+_Alignas(8) uint8_t fake_flash[FAKE_FLASH_SIZE];
+_Alignas(8) uint8_t fake_window[OVL_WINDOW_SIZE];
+
+fake_calls_t fake_calls;
+
+static union {
+    ovl_table_t table;
+    uint8_t bytes[sizeof(ovl_table_t) + OVL_COUNT * sizeof(ovl_desc_t)];
+} fake_tab;
+
+// running CRC; ovl_port_crc_begin() hands it out as the data register
+static volatile uint32_t fake_crc_dr;
+
+void fake_reset(void)
+{
+    memset(fake_flash, 0xFF, sizeof(fake_flash));
+    memset(fake_window, 0, sizeof(fake_window));
+    memset(&fake_calls, 0, sizeof(fake_calls));
+    fake_calls.fault_id = OVL_NONE;
+    fake_dma_script(0, OVL_DMA_DONE);
+}
+
+ovl_table_t *fake_table(const fake_overlay_t *ovl, unsigned n)
+{
+    ovl_table_t *t = &fake_tab.table;
+    size_t at = 0;
+
+    fake_reset();
+    memset(&fake_tab, 0, sizeof(fake_tab));
+    t->magic = OVL_TABLE_MAGIC;
+    t->count = n;
+    for (unsigned id = 0; id < n; id++) {
+        ovl_desc_t *d = &t->desc[id];
+
+        for (size_t i = 0; i < ovl[id].size; i++) {
+            fake_flash[at + i] = (uint8_t)(i * 7u + id * 61u + 1u);
+        }
+        d->id = id;
+        d->method = OVL_PACK_RAW;
+        d->lma = &fake_flash[at];
+        d->vma = &fake_window[ovl[id].offset];
+        d->size = (uint32_t)ovl[id].size;
+        d->packed_size = d->size;
+        d->crc = fake_crc(d->lma, d->size);
+        at += (ovl[id].size + 3u) & ~(size_t)3u;
+    }
+    return t;
+}
+
+int fake_in_window(const ovl_desc_t *d)
+{
+    return memcmp(d->vma, d->lma, d->size) == 0;
+}
+
+/*============================================================================
+ * CRC UNIT AND WORD COPIES (ovl_copy.S)
+ *============================================================================*/
+
+static uint32_t crc_word(uint32_t crc, uint32_t w)
+{
+    crc ^= w;
+    for (int i = 0; i < 32; i++) {
+        crc = crc & 0x80000000U ? crc << 1 ^ 0x04C11DB7U : crc << 1;
+    }
+    return crc;
+}
+
+uint32_t fake_crc(const void *p, size_t len)
+{
+    ovl_crc_words(p, len, ovl_port_crc_begin());
+    return ovl_port_crc_end();
+}
+
+void ovl_copy_words(void *dst, const void *src, size_t len)
+{
+    memcpy(dst, src, len);
+}
+
+void ovl_copy_words_crc(void *dst, const void *src, size_t len,
+                        volatile uint32_t *crc_dr)
+{
+    ovl_crc_words(src, len, crc_dr);
+    memcpy(dst, src, len);
+}
+
+void ovl_crc_words(const void *src, size_t len, volatile uint32_t *crc_dr)
+{
+    const uint8_t *p = src;
+
+    for (size_t i = 0; i < len; i += 4) {
+        uint32_t w;
+
+        memcpy(&w, p + i, 4);           // little-endian like the M0+
+        *crc_dr = crc_word(*crc_dr, w);
+    }
+}
+
+/*============================================================================
+ * PORT HOOKS
+ *============================================================================*/
+
+void ovl_port_init(void)
+{
+    fake_calls.inits++;
+}
+
+volatile uint32_t *ovl_port_crc_begin(void)
+{
+    fake_crc_dr = 0xFFFFFFFFU;
+    return &fake_crc_dr;
+}
+
+uint32_t ovl_port_crc_end(void)
+{
+    return fake_crc_dr;
+}
+
+int ovl_port_copy(const ovl_desc_t *d)
+{
+    fake_calls.copies++;
+    return ovl_image_load(d);
+}
+
+int ovl_port_check(const ovl_desc_t *d)
+{
+    fake_calls.checks++;
+    return ovl_crc_image(d->vma, d->size) == d->crc ? 0 : -1;
+}
+
+// transfer in flight, and the script for the next one
+static const ovl_desc_t *fake_dma_image;
+static unsigned fake_dma_busy;
+static int fake_dma_result;
+static uint8_t fake_dma_sync;               // packed image, decoded at start
+static unsigned fake_dma_next_busy;
+static int fake_dma_next_result = OVL_DMA_DONE;
+
+void fake_dma_script(unsigned busy, int result)
+{
+    fake_dma_next_busy = busy;
+    fake_dma_next_result = result;
+}
+
+void ovl_port_dma_start(const ovl_desc_t *d)
+{
+    fake_calls.dma_starts++;
+    fake_dma_image = d;
+    fake_dma_busy = fake_dma_next_busy;
+    fake_dma_result = fake_dma_next_result;
+    fake_dma_script(0, OVL_DMA_DONE);
+
+    // as on the board, DMA cannot decompress: packed images are decoded
+    // right here and the result is reported by the next poll
+    fake_dma_sync = d->method != OVL_PACK_RAW;
+    if (fake_dma_sync) {
+        fake_dma_result = ovl_port_copy(d) == 0 ? OVL_DMA_DONE : OVL_DMA_ERROR;
+    }
+}
+
+int ovl_port_dma_poll(void)
+{
+    const ovl_desc_t *d = fake_dma_image;
+
+    fake_calls.dma_polls++;
+    if (fake_dma_sync) {
+        fake_dma_sync = 0;
+        return fake_dma_result;
+    }
+    if (fake_dma_busy != 0) {
+        fake_dma_busy--;
+        return OVL_DMA_BUSY;
+    }
+    if (fake_dma_result == OVL_DMA_ERROR) {
+        memcpy(d->vma, d->lma, d->size / 2u);   // bus error half way
+        return OVL_DMA_ERROR;
+    }
+
+    // done: check the copy from SRAM, as the board's port does
+    memcpy(d->vma, d->lma, d->size);
+    return ovl_port_check(d) == 0 ? OVL_DMA_DONE : OVL_DMA_ERROR;
+}
+
+void ovl_port_fault(ovl_id_t id)
+{
+    fake_calls.faults++;
+    fake_calls.fault_id = id;
+}
@@ -0,0 +1,68 @@
+#ifndef OVL_FAKE_PORT_H
+#define OVL_FAKE_PORT_H
+
+#include "overlay.h"
+
+/*============================================================================
+ * FAKE PORT (host tests)
+ *============================================================================*/
+
+/*
+ * Stands in for overlay_port.c and ovl_copy.S on the host. Flash and
+ * the OVL window are RAM arrays, the CRC unit is a software model of
+ * the one tools/ovlpack.py computes the link-time values with, and DMA
+ * transfers follow a script.
+ */
+
+#define FAKE_FLASH_SIZE  (16U * 1024U)
+
+extern uint8_t fake_flash[FAKE_FLASH_SIZE];
+extern uint8_t fake_window[OVL_WINDOW_SIZE];
+
+/* Overlay of a fake table: run offset in the window and image bytes */
+typedef struct {
+    size_t offset;
+    size_t size;
+} fake_overlay_t;
+
+/* Erase fake flash, clear the window and fake_calls, drop the DMA script */
+void fake_reset(void);
+
+/*
+ * Lay out n (at most OVL_COUNT) raw overlays: a distinct pattern image
+ * per id in fake_flash, descriptors with its CRC, no entry points.
+ * Starts with fake_reset(). Returns the table for ovl_init(); tests
+ * may damage it or the images afterwards.
+ */
+ovl_table_t *fake_table(const fake_overlay_t *ovl, unsigned n);
+
+/*
+ * Script the next DMA transfer: ovl_port_dma_poll() reports it busy
+ * for `busy` polls, then returns result. OVL_DMA_DONE lands the image
+ * at that poll and still fails it on a CRC mismatch, like the board;
+ * OVL_DMA_ERROR leaves it half copied. Transfers nobody scripted
+ * complete on their first poll. Packed images ignore the script: they
+ * are decoded by the CPU when the transfer starts, as on the board.
+ */
+void fake_dma_script(unsigned busy, int result);
+
+/* Non-zero if the window holds the image of d at its run address */
+int fake_in_window(const ovl_desc_t *d);
+
+/* Port calls since fake_table() */
+typedef struct {
+    unsigned inits;
+    unsigned copies;            // ovl_port_copy()
+    unsigned checks;            // ovl_port_check()
+    unsigned dma_starts;
+    unsigned dma_polls;
+    unsigned faults;            // ovl_port_fault(), which returns here
+    ovl_id_t fault_id;          // id of the last one
+} fake_calls_t;
+
+extern fake_calls_t fake_calls;
+
+/* CRC unit model, as ovl_crc_image() computes it on the board */
+uint32_t fake_crc(const void *p, size_t len);
+
+#endif /* OVL_FAKE_PORT_H */
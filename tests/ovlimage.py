@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Packed overlay image for the host tests.
+
+Runs tools/ovlpack.py's build_table() on two made-up overlays, one of
+them incompressible so it stays raw and one that LZ4 shrinks, and writes
+a C header with the resulting table bytes, where it was packed for, and
+a few buffers with their stm32_crc() values. A second table packs the
+same overlays with the compressible one forced raw, as OVL_RAW does for
+the prefetched banks. test_ovl_store.c loads the
+table through ovl_store.c and the fake port, so the C check path runs
+against the CRCs and LZ4 streams the packer produces.
+"""
+
+import argparse
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'tools'))
+import ovlpack  # noqa: E402
+
+TABLE_BASE = 0x08008000
+WINDOW_BASE = 0x20001400
+
+# (name, run offset in the window, size, entry offsets)
+OVERLAYS = [
+    ('.ovl_rsa', 0, 1500, (0, 0x120)),
+    ('.ovl_prime', 2048, 900, (0,)),
+]
+
+
+def image(rng, name, size):
+    """Random bytes for the first overlay (stored raw); the other repeats
+    a short vocabulary of 'instructions', which LZ4 shrinks."""
+    if name == OVERLAYS[0][0]:
+        return bytes(rng.getrandbits(8) for _ in range(size))
+    words = [rng.getrandbits(16).to_bytes(2, 'little') for _ in range(24)]
+    return b''.join(rng.choice(words) for _ in range(size // 2))
+
+
+def c_bytes(data):
+    return ',\n'.join('    ' + ', '.join('0x%02x' % b for b in data[i:i + 12])
+                      for i in range(0, len(data), 12))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('-o', '--output', required=True, help='output header')
+    args = ap.parse_args()
+
+    rng = random.Random(0x4F564C54)
+    images = [(name, WINDOW_BASE + off, image(rng, name, size),
+               [WINDOW_BASE + off + e + 1 for e in entries])
+              for name, off, size, entries in OVERLAYS]
+    table, _ = ovlpack.build_table(TABLE_BASE, images, 'lz4')
+    raw_table, _ = ovlpack.build_table(TABLE_BASE, images, 'lz4', (OVERLAYS[1][0],))
+    vectors = [bytes(rng.getrandbits(8) for _ in range(4 * n)) for n in (1, 2, 7, 64)]
+
+    out = ['/* Generated by tests/ovlimage.py -- do not edit. */', '',
+           '#define OVL_IMAGE_BASE   0x%08XU' % TABLE_BASE,
+           '#define OVL_WINDOW_BASE  0x%08XU' % WINDOW_BASE, '',
+           '/* ovlpack.py build_table() output for OVL_IMAGE_BASE */',
+           'static const uint8_t ovl_image[%d] = {' % len(table),
+           c_bytes(table), '};', '',
+           '/* the same with %s in raw_names */' % OVERLAYS[1][0],
+           'static const uint8_t ovl_image_raw[%d] = {' % len(raw_table),
+           c_bytes(raw_table), '};', '',
+           '/* Buffers and their stm32_crc() */']
+    for i, v in enumerate(vectors):
+        out += ['static const uint8_t crc_vector%d[%d] = {' % (i, len(v)), c_bytes(v), '};']
+    out += ['static const struct {',
+            '    const uint8_t *data;',
+            '    size_t len;',
+            '    uint32_t crc;',
+            '} crc_vectors[] = {']
+    out += ['    { crc_vector%d, %d, 0x%08XU },' % (i, len(v), ovlpack.stm32_crc(v))
+            for i, v in enumerate(vectors)]
+    out += ['};', '']
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,65 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*============================================================================
+ * HOST TEST HELPERS
+ *============================================================================*/
+
+/*
+ * Every test program has its own main() and includes this once; a
+ * failed CHECK prints where and keeps going, and test_report() turns
+ * the tally into the exit status `make test` looks at.
+ */
+static unsigned test_checks;
+static unsigned test_failures;
+
+#define CHECK(cond)                                                     \
+    do {                                                                \
+        test_checks++;                                                  \
+        if (!(cond)) {                                                  \
+            test_failures++;                                            \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        }                                                               \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                  \
+    do {                                                                \
+        unsigned long long check_a_ = (unsigned long long)(a);          \
+        unsigned long long check_b_ = (unsigned long long)(b);          \
+        test_checks++;                                                  \
+        if (check_a_ != check_b_) {                                     \
+            test_failures++;                                            \
+            printf("%s:%d: %s == %s failed (0x%llx != 0x%llx)\n",       \
+                   __FILE__, __LINE__, #a, #b, check_a_, check_b_);     \
+        }                                                               \
+    } while (0)
+
+#define RUN(test)                                                       \
+    do {                                                                \
+        unsigned run_failures_ = test_failures;                         \
+        test();                                                         \
+        printf("  %-32s %s\n", #test,                                   \
+               test_failures == run_failures_ ? "ok" : "FAILED");       \
+    } while (0)
+
+static inline int test_report(const char *name)
+{
+    printf("%s: %u checks, %u failed\n", name, test_checks, test_failures);
+    return test_failures != 0;
+}
+
+/* xorshift32; the tests seed it so every run sees the same inputs */
+static uint32_t test_rng = 0x2545F491U;
+
+static inline uint32_t test_rand(void)
+{
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 17;
+    test_rng ^= test_rng << 5;
+    return test_rng;
+}
+
+#endif /* TEST_H */
@@ -0,0 +1,78 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * Keys of the size the kernels are built for (BR_I15_FIXED_BITS) and of
+ * other sizes: br_rsa_i15_public() and the precomputed-key path match
+ * the reference on every key of the fixed word count (BR_I15_FIXED_LEN,
+ * which spans a few bit lengths) and refuse the others, which the
+ * reference accepts. In a generic build every size is accepted.
+ */
+
+static const unsigned sizes[] = {
+    2048, 2041, 2040, 1024, 1500, 1020, 521, 255, 17,
+#if BR_I15_FIXED_BITS
+    BR_I15_FIXED_BITS, BR_I15_FIXED_BITS - 7, BR_I15_FIXED_BITS - 8,
+#endif
+};
+
+static unsigned char n[BR_MAX_RSA_SIZE / 8];
+
+/* The engines under test take a key of this many bits */
+static int accepted(unsigned bits)
+{
+#if BR_I15_FIXED_BITS
+    return (bits + 14) / 15 == BR_I15_FIXED_LEN;
+#else
+    (void)bits;
+    return 1;
+#endif
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_fixed_public(void)
+{
+    static unsigned char e[] = { 0x01, 0x00, 0x01 };
+    uint16_t m[2 + (BR_MAX_RSA_SIZE + 14) / 15];
+    unsigned char x[sizeof(n)], want[sizeof(n)], got[sizeof(n)];
+    br_rsa_i15_pubctx ctx;
+
+    for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > BR_MAX_RSA_SIZE) {
+            continue;
+        }
+        int ctx_ok = sizes[i] <= BR_RSA_I15_PUBCTX_MAX_BITS;
+        br_rsa_public_key pk = { n, i15_random_mod(m, n, sizes[i]), e, sizeof(e) };
+
+        i15_random_bytes(x, pk.nlen);
+        x[0] = n[0] >> 1;
+        memcpy(want, x, pk.nlen);
+        CHECK_EQ(ref_br_rsa_i15_public(want, pk.nlen, &pk), 1);
+
+        if (accepted(sizes[i])) {
+            memcpy(got, x, pk.nlen);
+            CHECK_EQ(br_rsa_i15_public(got, pk.nlen, &pk), 1);
+            CHECK(memcmp(got, want, pk.nlen) == 0);
+
+            CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), ctx_ok);
+            if (ctx_ok) {
+                memcpy(got, x, pk.nlen);
+                CHECK_EQ(br_rsa_i15_public_ctx(got, pk.nlen, &ctx), 1);
+                CHECK(memcmp(got, want, pk.nlen) == 0);
+            }
+        } else {
+            CHECK_EQ(br_rsa_i15_public(x, pk.nlen, &pk), 0);
+            CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 0);
+        }
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0xF1CED019U);
+    RUN(test_fixed_public);
+    return test_report("test_fixed");
+}
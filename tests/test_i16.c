@@ -0,0 +1,145 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * The i16 engine against the reference i15 one: br_rsa_i16_public()
+ * and br_i16_modpow_vartime() on random moduli of several sizes (the
+ * i16 code is not built for a fixed size), with the byte encodings of
+ * the results compared.
+ */
+
+#define ROUNDS  14
+
+static const unsigned sizes[] = { 2048, 1024, 521, 1020, 1500, 255, 17, 16 };
+
+static unsigned char n[I15_TEST_BITS / 8];
+static size_t nlen;
+static uint16_t m15[I15_WORDS], m16[I15_WORDS];
+static uint16_t m0i15, m0i16;
+static uint16_t t1[I15_WORDS], t2[I15_WORDS];
+
+static void random_modulus(unsigned round)
+{
+    unsigned bits = sizes[round % (sizeof(sizes) / sizeof(sizes[0]))];
+
+    nlen = i15_random_mod(m15, n, bits);
+    m0i15 = br_i15_ninv15(m15[1]);
+    br_i16_decode(m16, n, nlen);
+    m0i16 = br_i16_ninv16(m16[1]);
+}
+
+/* Random value below n, big-endian over nlen bytes */
+static void random_below(unsigned char *x)
+{
+    uint16_t v[I15_WORDS];
+
+    i15_random_below(v, m15);
+    br_i15_encode(x, nlen, v);
+}
+
+/* x^e mod n by br_i16_modpow_vartime() and the reference agree */
+static void check_modpow(const unsigned char *x, const unsigned char *e, size_t elen)
+{
+    unsigned char want[sizeof(n)], got[sizeof(n)];
+    uint16_t a[I15_WORDS];
+
+    CHECK_EQ(ref_br_i15_decode_mod(a, x, nlen, m15), 1);
+    ref_br_i15_modpow(a, e, elen, m15, m0i15, t1, t2);
+    br_i15_encode(want, nlen, a);
+
+    CHECK_EQ(br_i16_decode_mod(a, x, nlen, m16), 1);
+    br_i16_modpow_vartime(a, e, elen, m16, m0i16, NULL, t1, t2);
+    br_i16_encode(got, nlen, a);
+    CHECK(memcmp(got, want, nlen) == 0);
+}
+
+/* x^e mod n by both RSA public engines agree */
+static void check_public(const unsigned char *x, const unsigned char *e, size_t elen)
+{
+    unsigned char want[sizeof(n)], got[sizeof(n)];
+    br_rsa_public_key pk = { n, nlen, (unsigned char *)e, elen };
+
+    memcpy(want, x, nlen);
+    CHECK_EQ(ref_br_rsa_i15_public(want, nlen, &pk), 1);
+    memcpy(got, x, nlen);
+    CHECK_EQ(br_rsa_i16_public(got, nlen, &pk), 1);
+    CHECK(memcmp(got, want, nlen) == 0);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_i16_modpow(void)
+{
+    unsigned char x[sizeof(n)], e[24];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        for (unsigned i = 0; i < 6; i++) {
+            size_t elen = 1 + test_rand() % sizeof(e);
+
+            random_below(x);
+            i15_random_bytes(e, elen);
+            check_modpow(x, e, elen);
+        }
+    }
+}
+
+static void test_i16_public(void)
+{
+    static const unsigned char e3[] = { 0x03 };
+    static const unsigned char f4[] = { 0x01, 0x00, 0x01 };
+    unsigned char x[sizeof(n)], e[4];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        random_below(x);
+        check_public(x, e3, sizeof(e3));
+        check_public(x, f4, sizeof(f4));
+
+        i15_random_bytes(e, sizeof(e));
+        e[3] |= 1;
+        check_public(x, e, sizeof(e));
+
+        // 0, 1 and n-1
+        memset(x, 0, nlen);
+        check_public(x, f4, sizeof(f4));
+        x[nlen - 1] = 1;
+        check_public(x, f4, sizeof(f4));
+        memcpy(x, n, nlen);
+        x[nlen - 1]--;
+        check_public(x, f4, sizeof(f4));
+    }
+}
+
+static void test_i16_public_rejects(void)
+{
+    static const unsigned char f4[] = { 0x01, 0x00, 0x01 };
+    unsigned char x[sizeof(n) + 1];
+    br_rsa_public_key pk = { n, 0, (unsigned char *)f4, sizeof(f4) };
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        pk.nlen = nlen;
+
+        // x == n is out of range, as for i15
+        memcpy(x, n, nlen);
+        CHECK_EQ(br_rsa_i16_public(x, nlen, &pk), 0);
+        memcpy(x, n, nlen);
+        CHECK_EQ(ref_br_rsa_i15_public(x, nlen, &pk), 0);
+
+        // and x must have the length of n
+        memset(x, 0, sizeof(x));
+        CHECK_EQ(br_rsa_i16_public(x, nlen + 1, &pk), 0);
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x1616C0DEU);
+    RUN(test_i16_modpow);
+    RUN(test_i16_public);
+    RUN(test_i16_public_rejects);
+    return test_report("test_i16");
+}
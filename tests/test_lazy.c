@@ -0,0 +1,200 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * The lazy ("almost Montgomery") products: results below 2m and
+ * congruent to the reference product, including on operands in
+ * [m, 2m) and along long chains; br_i15_from_monty() on lazy values;
+ * and the exponentiations that use them (br_i15_modpow_opt() and
+ * br_i15_modpow_vartime()) against the reference br_i15_modpow(), on
+ * moduli with room for them and, in a generic build, on moduli whose
+ * top word is too full (br_i15_lazy_ok() false).
+ */
+
+#define ROUNDS  12
+#define CHAIN   64
+
+static uint16_t m[I15_WORDS], t1[I15_WORDS], t2[I15_WORDS];
+static uint16_t m0i;
+static unsigned char n[I15_TEST_BITS / 8];
+static uint16_t tmp[12 * I15_WORDS];
+
+static void random_modulus(unsigned bits)
+{
+    i15_random_mod(m, n, bits);
+    m0i = br_i15_ninv15(m[1]);
+}
+
+/* Lazy modulus for round r */
+static unsigned lazy_bits(unsigned r)
+{
+    unsigned bits = i15_test_bits(r);
+
+    // at most 13 bits in the top word
+    while (bits % 15 == 0 || bits % 15 == 14) {
+        bits--;
+    }
+    return bits;
+}
+
+/* Random value in [0, 2m), in [m, 2m) half of the time */
+static void random_below2(uint16_t *x)
+{
+    i15_random_below(x, m);
+    ref_br_i15_add(x, m, test_rand() & 1);
+}
+
+/* d is in [0, 2m) and congruent to want (in [0, m)) */
+static void check_lazy(const uint16_t *d, const uint16_t *want)
+{
+    uint16_t r[I15_WORDS];
+
+    memcpy(r, d, sizeof(r));
+    ref_br_i15_sub(r, m, !i15_below(r, m));
+    CHECK(i15_below(r, m));
+    CHECK(i15_equal(r, want));
+}
+
+/* x mod m, for x in [0, 2m) */
+static void reduce(uint16_t *r, const uint16_t *x)
+{
+    memcpy(r, x, sizeof(uint16_t) * I15_WORDS);
+    ref_br_i15_sub(r, m, !i15_below(r, m));
+}
+
+/* x^e by the exponentiations under test and the reference agree */
+static void check_pow(const uint16_t *x, const unsigned char *e, size_t elen)
+{
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+    size_t size = (((m[0] + 15) >> 4) + 1) * sizeof(uint16_t);
+
+    memcpy(want, x, size);
+    ref_br_i15_modpow(want, e, elen, m, m0i, t1, t2);
+
+    memcpy(got, x, size);
+    CHECK_EQ(br_i15_modpow_opt(got, e, elen, m, m0i, tmp,
+                               sizeof(tmp) / sizeof(tmp[0])), 1);
+    CHECK(i15_equal(got, want));
+
+    memcpy(got, x, size);
+    br_i15_modpow_vartime(got, e, elen, m, m0i, NULL, t1, t2);
+    CHECK(i15_equal(got, want));
+}
+
+static void check_pows(void)
+{
+    static const unsigned char f4[] = { 0x01, 0x00, 0x01 };
+    uint16_t x[I15_WORDS];
+    unsigned char e[16];
+
+    for (unsigned i = 0; i < 4; i++) {
+        i15_random_below(x, m);
+        i15_random_bytes(e, sizeof(e));
+        check_pow(x, e, 1 + i * 5);
+        check_pow(x, f4, sizeof(f4));
+    }
+
+    // m-1, the largest value
+    memcpy(x, m, sizeof(x));
+    x[1]--;
+    check_pow(x, f4, sizeof(f4));
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_lazy_products(void)
+{
+    uint16_t x[I15_WORDS], y[I15_WORDS], xr[I15_WORDS], yr[I15_WORDS];
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(lazy_bits(r));
+        CHECK(br_i15_lazy_ok(m));
+
+        for (unsigned i = 0; i < 16; i++) {
+            random_below2(x);
+            random_below2(y);
+            reduce(xr, x);
+            reduce(yr, y);
+
+            ref_br_i15_montymul(want, xr, yr, m, m0i);
+            br_i15_montymul_lazy(got, x, y, m, m0i);
+            check_lazy(got, want);
+
+            ref_br_i15_montymul(want, xr, xr, m, m0i);
+            br_i15_montysqr_lazy(got, x, m, m0i);
+            check_lazy(got, want);
+
+            // from_monty takes the lazy value and reduces it
+            memcpy(want, xr, sizeof(want));
+            ref_br_i15_from_monty(want, m, m0i);
+            br_i15_from_monty(x, m, m0i);
+            CHECK(i15_equal(x, want));
+        }
+    }
+}
+
+static void test_lazy_chain(void)
+{
+    uint16_t x[I15_WORDS], y[I15_WORDS], a[I15_WORDS], b[I15_WORDS];
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(lazy_bits(r));
+        i15_random_below(x, m);
+        i15_random_below(y, m);
+        memcpy(a, x, sizeof(a));
+        memcpy(want, x, sizeof(want));
+
+        // unreduced values feed the next product, as in the modpows
+        for (unsigned i = 0; i < CHAIN; i++) {
+            if (i % 3 == 2) {
+                br_i15_montymul_lazy(b, a, y, m, m0i);
+                ref_br_i15_montymul(got, want, y, m, m0i);
+            } else {
+                br_i15_montysqr_lazy(b, a, m, m0i);
+                ref_br_i15_montymul(got, want, want, m, m0i);
+            }
+            memcpy(want, got, sizeof(want));
+            memcpy(a, b, sizeof(a));
+            check_lazy(a, want);
+        }
+    }
+}
+
+static void test_lazy_modpow(void)
+{
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(lazy_bits(r));
+        check_pows();
+    }
+}
+
+static void test_full_top_word_modpow(void)
+{
+#if BR_I15_FIXED_BITS
+    // every modulus of the fixed size leaves room for the lazy products
+    random_modulus(BR_I15_FIXED_BITS);
+    CHECK(br_i15_lazy_ok(m));
+#else
+    static const unsigned bits[] = { 1019, 1020, 2039, 254, 240 };
+
+    for (unsigned r = 0; r < sizeof(bits) / sizeof(bits[0]); r++) {
+        random_modulus(bits[r]);
+        CHECK(!br_i15_lazy_ok(m));
+        check_pows();
+    }
+#endif
+}
+
+int main(void)
+{
+    i15_test_init(0x1A2E0018U);
+    RUN(test_lazy_products);
+    RUN(test_lazy_chain);
+    RUN(test_lazy_modpow);
+    RUN(test_full_top_word_modpow);
+    return test_report("test_lazy");
+}
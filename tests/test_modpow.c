@@ -0,0 +1,162 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * The constant-time exponentiations with ping-pong buffers:
+ * br_i15_modpow() and br_i15_modpow_opt() (every window size) against
+ * a plain square-and-multiply on the reference montymul, which shares
+ * none of their buffer handling; and br_i15_ccopy(), which selects
+ * their products, against a word loop.
+ */
+
+#define ROUNDS  6
+
+static uint16_t m[I15_WORDS], t1[I15_WORDS], t2[I15_WORDS];
+static uint16_t m0i;
+static size_t mwlen;
+static unsigned char n[I15_TEST_BITS / 8];
+static uint16_t tmp[33 * (I15_WORDS + 1)];
+
+static void random_modulus(unsigned round)
+{
+    i15_random_mod(m, n, i15_test_bits(round));
+    m0i = br_i15_ninv15(m[1]);
+
+    // words per integer in br_i15_modpow_opt()
+    mwlen = (m[0] + 31) >> 4;
+    mwlen += mwlen & 1;
+}
+
+/* x <- x^e mod m, left to right, one bit at a time */
+static void slow_pow(uint16_t *x, const unsigned char *e, size_t elen)
+{
+    uint16_t acc[I15_WORDS], xm[I15_WORDS], t[I15_WORDS];
+    size_t size = (((m[0] + 15) >> 4) + 1) * sizeof(uint16_t);
+
+    memcpy(xm, x, size);
+    ref_br_i15_to_monty(xm, m);
+    br_i15_zero(acc, m[0]);
+    acc[1] = 1;
+    ref_br_i15_to_monty(acc, m);
+
+    for (size_t k = 0; k < elen * 8; k++) {
+        ref_br_i15_montymul(t, acc, acc, m, m0i);
+        if ((e[k >> 3] >> (7 - (k & 7))) & 1) {
+            ref_br_i15_montymul(acc, t, xm, m, m0i);
+        } else {
+            memcpy(acc, t, size);
+        }
+    }
+    ref_br_i15_from_monty(acc, m, m0i);
+    memcpy(x, acc, size);
+}
+
+/* x^e by both exponentiations, at every window size, and slow_pow() agree */
+static void check_pow(const uint16_t *x, const unsigned char *e, size_t elen)
+{
+    static const size_t windows[] = { 2, 3, 5, 9, 17, 33 };
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+    size_t size = (((m[0] + 15) >> 4) + 1) * sizeof(uint16_t);
+
+    memcpy(want, x, size);
+    slow_pow(want, e, elen);
+
+    memcpy(got, x, size);
+    br_i15_modpow(got, e, elen, m, m0i, t1, t2);
+    CHECK(i15_equal(got, want));
+
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        memcpy(got, x, size);
+        CHECK_EQ(br_i15_modpow_opt(got, e, elen, m, m0i, tmp, windows[w] * mwlen), 1);
+        CHECK(i15_equal(got, want));
+    }
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_modpow_random(void)
+{
+    static const size_t elens[] = { 1, 2, 3, 5, 16, 33, 64 };
+    uint16_t x[I15_WORDS];
+    unsigned char e[64];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        for (size_t i = 0; i < sizeof(elens) / sizeof(elens[0]); i++) {
+            i15_random_below(x, m);
+            i15_random_bytes(e, elens[i]);
+            check_pow(x, e, elens[i]);
+        }
+    }
+}
+
+static void test_modpow_edges(void)
+{
+    static const unsigned char zero[] = { 0x00, 0x00, 0x00 };
+    static const unsigned char one[] = { 0x00, 0x01 };
+    static const unsigned char ones[] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    static const unsigned char sparse[] = { 0x80, 0x00, 0x00, 0x01 };
+    uint16_t x[I15_WORDS];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        i15_random_below(x, m);
+        check_pow(x, zero, sizeof(zero));
+        check_pow(x, one, sizeof(one));
+        check_pow(x, ones, sizeof(ones));
+        check_pow(x, sparse, sizeof(sparse));
+
+        // 0, 1 and m-1
+        br_i15_zero(x, m[0]);
+        check_pow(x, ones, sizeof(ones));
+        x[1] = 1;
+        check_pow(x, ones, sizeof(ones));
+        memcpy(x, m, sizeof(x));
+        x[1]--;
+        check_pow(x, ones, sizeof(ones));
+        check_pow(x, sparse, sizeof(sparse));
+    }
+}
+
+static void test_modpow_opt_short_tmp(void)
+{
+    static const unsigned char e[] = { 0x01, 0x00, 0x01 };
+    uint16_t x[I15_WORDS];
+
+    random_modulus(0);
+    i15_random_below(x, m);
+    CHECK_EQ(br_i15_modpow_opt(x, e, sizeof(e), m, m0i, tmp, 2 * mwlen - 1), 0);
+}
+
+static void test_ccopy(void)
+{
+    uint16_t d[80], s[80], want[80];
+
+    for (unsigned i = 0; i < 400; i++) {
+        size_t doff = test_rand() % 4, soff = test_rand() % 4;
+        size_t len = test_rand() % 70;
+        uint32_t ctl = test_rand() & 1;
+
+        i15_random_bytes(d, sizeof(d));
+        i15_random_bytes(s, sizeof(s));
+        memcpy(want, d, sizeof(d));
+        if (ctl) {
+            memcpy(want + doff, s + soff, len * sizeof(uint16_t));
+        }
+
+        br_i15_ccopy(ctl, d + doff, s + soff, len);
+        CHECK(memcmp(d, want, sizeof(d)) == 0);
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0xC0FFEE21U);
+    RUN(test_modpow_random);
+    RUN(test_modpow_edges);
+    RUN(test_modpow_opt_short_tmp);
+    RUN(test_ccopy);
+    return test_report("test_modpow");
+}
@@ -0,0 +1,125 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * br_i15_modpow_vartime() against the reference constant-time
+ * br_i15_modpow(), on random moduli and values, for the 2^k+1 chain,
+ * the generic square-and-multiply and the trivial exponents, with and
+ * without R^2 supplied.
+ */
+
+#define ROUNDS  6
+
+static uint16_t m[I15_WORDS], r2[I15_WORDS], t1[I15_WORDS], t2[I15_WORDS];
+static uint16_t m0i;
+static unsigned char n[I15_TEST_BITS / 8];
+
+static void random_modulus(unsigned round)
+{
+    i15_random_mod(m, n, i15_test_bits(round));
+    m0i = br_i15_ninv15(m[1]);
+
+    // R^2 mod m, the slow way
+    br_i15_zero(r2, m[0]);
+    r2[1] = 1;
+    ref_br_i15_to_monty(r2, m);
+    ref_br_i15_to_monty(r2, m);
+}
+
+/* x^e, by both implementations and with both conversions, agree */
+static void check_pow(const uint16_t *x, const unsigned char *e, size_t elen)
+{
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+    size_t size = (((m[0] + 15) >> 4) + 1) * sizeof(uint16_t);
+
+    memcpy(want, x, size);
+    ref_br_i15_modpow(want, e, elen, m, m0i, t1, t2);
+
+    memcpy(got, x, size);
+    br_i15_modpow_vartime(got, e, elen, m, m0i, NULL, t1, t2);
+    CHECK(i15_equal(got, want));
+
+    memcpy(got, x, size);
+    br_i15_modpow_vartime(got, e, elen, m, m0i, r2, t1, t2);
+    CHECK(i15_equal(got, want));
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_vartime_fixed_chain(void)
+{
+    uint16_t x[I15_WORDS];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        i15_random_below(x, m);
+
+        // 2^k+1 for every k that fits three bytes: 3, 5, 9, ..., 65537, ...
+        for (unsigned k = 1; k < 24; k++) {
+            uint32_t ev = (1u << k) + 1u;
+            unsigned char e[3] = { (unsigned char)(ev >> 16), (unsigned char)(ev >> 8),
+                                   (unsigned char)ev };
+            check_pow(x, e, sizeof(e));
+        }
+    }
+}
+
+static void test_vartime_generic(void)
+{
+    uint16_t x[I15_WORDS];
+    unsigned char e[24];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        for (unsigned i = 0; i < 8; i++) {
+            size_t elen = 1 + test_rand() % sizeof(e);
+
+            i15_random_below(x, m);
+            i15_random_bytes(e, elen);
+            if (i & 1) {
+                e[0] = 0;               // leading zero byte
+            }
+            check_pow(x, e, elen);
+        }
+
+        // 2^k+1 that do not fit the chain, and 2^k+3
+        static const unsigned char big[] = { 0x01, 0x00, 0x00, 0x01 };
+        static const unsigned char off[] = { 0x01, 0x00, 0x03 };
+        i15_random_below(x, m);
+        check_pow(x, big, sizeof(big));
+        check_pow(x, off, sizeof(off));
+    }
+}
+
+static void test_vartime_trivial(void)
+{
+    static const unsigned char zero[] = { 0x00, 0x00 };
+    static const unsigned char one[] = { 0x00, 0x01 };
+    static const unsigned char two[] = { 0x02 };
+    uint16_t x[I15_WORDS];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_modulus(r);
+        i15_random_below(x, m);
+        check_pow(x, zero, sizeof(zero));
+        check_pow(x, one, sizeof(one));
+        check_pow(x, two, sizeof(two));
+
+        // x = 0 and x = 1
+        br_i15_zero(x, m[0]);
+        check_pow(x, two, sizeof(two));
+        x[1] = 1;
+        check_pow(x, two, sizeof(two));
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x0B11CE11U);
+    RUN(test_vartime_fixed_chain);
+    RUN(test_vartime_generic);
+    RUN(test_vartime_trivial);
+    return test_report("test_modpow_vt");
+}
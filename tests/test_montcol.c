@@ -0,0 +1,78 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * The column-wise (Comba, BR_I15_COMBA) br_i15_montymul() against the
+ * reference row-by-row one, on random moduli and operands plus the
+ * edges 0, 1 and m-1 on either side.
+ */
+
+#define ROUNDS  40
+#define VALUES  16
+
+static void check_mul(const uint16_t *x, const uint16_t *y,
+                      const uint16_t *m, uint16_t m0i)
+{
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+
+    ref_br_i15_montymul(want, x, y, m, m0i);
+    memset(got, 0xFF, sizeof(got));
+    br_i15_montymul(got, x, y, m, m0i);
+    CHECK(i15_equal(got, want));
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_montcol_random(void)
+{
+    uint16_t m[I15_WORDS], x[I15_WORDS], y[I15_WORDS];
+    unsigned char n[I15_TEST_BITS / 8];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_random_mod(m, n, i15_test_bits(r));
+        uint16_t m0i = br_i15_ninv15(m[1]);
+
+        for (unsigned i = 0; i < VALUES; i++) {
+            i15_random_below(x, m);
+            i15_random_below(y, m);
+            check_mul(x, y, m, m0i);
+        }
+    }
+}
+
+static void test_montcol_edges(void)
+{
+    uint16_t m[I15_WORDS], e[3][I15_WORDS], y[I15_WORDS];
+    unsigned char n[I15_TEST_BITS / 8];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_random_mod(m, n, i15_test_bits(r));
+        uint16_t m0i = br_i15_ninv15(m[1]);
+
+        // 0, 1 and m-1 (every column at its largest)
+        br_i15_zero(e[0], m[0]);
+        br_i15_zero(e[1], m[0]);
+        e[1][1] = 1;
+        memcpy(e[2], m, sizeof(e[2]));
+        e[2][1]--;
+
+        i15_random_below(y, m);
+        for (unsigned i = 0; i < 3; i++) {
+            check_mul(e[i], y, m, m0i);
+            check_mul(y, e[i], m, m0i);
+            for (unsigned j = 0; j < 3; j++) {
+                check_mul(e[i], e[j], m, m0i);
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0xC0BA0016U);
+    RUN(test_montcol_random);
+    RUN(test_montcol_edges);
+    return test_report("test_montcol");
+}
@@ -0,0 +1,69 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * br_i15_montysqr() against the reference br_i15_montymul(d, x, x),
+ * on random moduli and values plus the edges 0, 1 and m-1.
+ */
+
+#define ROUNDS  40
+#define VALUES  16
+
+static void check_sqr(const uint16_t *x, const uint16_t *m, uint16_t m0i)
+{
+    uint16_t want[I15_WORDS], got[I15_WORDS];
+
+    ref_br_i15_montymul(want, x, x, m, m0i);
+    memset(got, 0xFF, sizeof(got));
+    br_i15_montysqr(got, x, m, m0i);
+    CHECK(i15_equal(got, want));
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_montysqr_random(void)
+{
+    uint16_t m[I15_WORDS], x[I15_WORDS];
+    unsigned char n[I15_TEST_BITS / 8];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_random_mod(m, n, i15_test_bits(r));
+        uint16_t m0i = br_i15_ninv15(m[1]);
+
+        for (unsigned i = 0; i < VALUES; i++) {
+            i15_random_below(x, m);
+            check_sqr(x, m, m0i);
+        }
+    }
+}
+
+static void test_montysqr_edges(void)
+{
+    uint16_t m[I15_WORDS], x[I15_WORDS];
+    unsigned char n[I15_TEST_BITS / 8];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_random_mod(m, n, i15_test_bits(r));
+        uint16_t m0i = br_i15_ninv15(m[1]);
+
+        br_i15_zero(x, m[0]);
+        check_sqr(x, m, m0i);
+        x[1] = 1;
+        check_sqr(x, m, m0i);
+
+        // m-1: every column at its largest
+        memcpy(x, m, sizeof(x));
+        x[1]--;
+        check_sqr(x, m, m0i);
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x5C0A12EDU);
+    RUN(test_montysqr_random);
+    RUN(test_montysqr_edges);
+    return test_report("test_montysqr");
+}
@@ -0,0 +1,322 @@
+#include <string.h>
+
+#include "ovl_fake_port.h"
+#include "test.h"
+
+/*
+ * Overlay manager (overlay.c) against the fake port: residency, pins,
+ * eviction, the scratch arena, the fault hook and DMA prefetch.
+ */
+
+#if OVL_COUNT < 2
+#error "the layouts below need two overlay ids"
+#endif
+
+/* 0 and 1 side by side in the lower 2 KB; the top 1 KB stays free */
+static const fake_overlay_t apart[] = {
+    { 0,    1000 },             // slots 0..3
+    { 1024, 1024 },             // slots 4..7
+};
+
+/* 1 covers the top of 0 */
+static const fake_overlay_t overlap[] = {
+    { 0,    1000 },             // slots 0..3
+    { 512,  1024 },             // slots 2..5
+};
+
+static void setup(const fake_overlay_t *layout)
+{
+    ovl_init(fake_table(layout, 2), fake_window);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_init_bad_magic(void)
+{
+    ovl_table_t *t = fake_table(apart, 2);
+
+    t->magic ^= 1u;
+    ovl_init(t, fake_window);
+    CHECK_EQ(fake_calls.inits, 1);
+    CHECK(ovl_acquire(0) == NULL);
+    CHECK(ovl_get_desc(0) == NULL);
+    CHECK(ovl_get_stats(0) == NULL);
+    CHECK(!ovl_prefetch(0));
+    CHECK(!ovl_is_resident(0));
+    CHECK_EQ(fake_calls.copies, 0);
+
+    // nothing is loadable, so the whole window is free
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+}
+
+static void test_acquire_miss_then_hit(void)
+{
+    setup(apart);
+    CHECK(!ovl_is_resident(0));
+
+    CHECK(ovl_acquire(0) == &fake_window[0]);
+    CHECK(ovl_is_resident(0));
+    CHECK(fake_in_window(ovl_get_desc(0)));
+    CHECK_EQ(fake_calls.copies, 1);
+    CHECK_EQ(ovl_get_stats(0)->loads, 1);
+    CHECK_EQ(ovl_get_stats(0)->hits, 0);
+    ovl_release(0);
+
+    // still resident after the release: no second copy
+    CHECK(ovl_acquire(0) == &fake_window[0]);
+    CHECK_EQ(fake_calls.copies, 1);
+    CHECK_EQ(ovl_get_stats(0)->loads, 1);
+    CHECK_EQ(ovl_get_stats(0)->hits, 1);
+    ovl_release(0);
+
+    CHECK(ovl_acquire(OVL_COUNT) == NULL);
+    CHECK(ovl_acquire(OVL_NONE) == NULL);
+}
+
+static void test_acquire_pinned_occupant(void)
+{
+    setup(overlap);
+    CHECK(ovl_acquire(0) != NULL);
+
+    // 1 needs slots 2..3, held by the pinned 0
+    CHECK(ovl_acquire(1) == NULL);
+    CHECK(!ovl_prefetch(1));
+    CHECK(ovl_is_resident(0));
+    CHECK(!ovl_is_resident(1));
+    CHECK_EQ(ovl_get_stats(0)->evictions, 0);
+    CHECK_EQ(fake_calls.copies, 1);
+
+    // pins nest: one release is not enough after two acquires
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+    CHECK(ovl_acquire(1) == NULL);
+    ovl_release(0);
+
+    CHECK(ovl_acquire(1) == &fake_window[512]);
+    CHECK(!ovl_is_resident(0));
+    CHECK_EQ(ovl_get_stats(0)->evictions, 1);
+    ovl_release(1);
+
+    // a stray release does not underflow the pin count
+    ovl_release(0);
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+}
+
+static void test_make_room_evicts_overlaps(void)
+{
+    setup(apart);
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+
+    // 1 loads next to 0 without evicting it
+    CHECK(ovl_acquire(1) != NULL);
+    CHECK(ovl_is_resident(0));
+    CHECK_EQ(ovl_get_stats(0)->evictions, 0);
+    ovl_release(1);
+
+    setup(overlap);
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+
+    // 1 covers the top of 0: it goes
+    CHECK(ovl_acquire(1) != NULL);
+    CHECK(fake_in_window(ovl_get_desc(1)));
+    CHECK(!ovl_is_resident(0));
+    CHECK_EQ(ovl_get_stats(0)->evictions, 1);
+    ovl_release(1);
+
+    // and bringing 0 back pushes out 1
+    CHECK(ovl_acquire(0) != NULL);
+    CHECK(fake_in_window(ovl_get_desc(0)));
+    CHECK(!ovl_is_resident(1));
+    CHECK_EQ(ovl_get_stats(1)->evictions, 1);
+    CHECK_EQ(ovl_get_stats(0)->loads, 2);
+    ovl_release(0);
+}
+
+static void test_scratch_overlaps_overlay(void)
+{
+    size_t len = 0;
+    uint8_t *p;
+
+    setup(apart);
+
+    // nothing resident: the whole window, and only once
+    p = ovl_scratch_acquire(64, &len);
+    CHECK(p == fake_window);
+    CHECK_EQ(len, OVL_WINDOW_SIZE);
+    CHECK(ovl_scratch_acquire(0, &len) == NULL);
+    CHECK_EQ(ovl_scratch_avail(), 0);
+
+    // every overlay lands on the lent bytes
+    CHECK(ovl_acquire(0) == NULL);
+    CHECK(!ovl_prefetch(1));
+    CHECK_EQ(fake_calls.copies, 0);
+    CHECK_EQ(fake_calls.dma_starts, 0);
+    ovl_scratch_release();
+
+    // with 0 resident, the gap starts 8-byte aligned behind it
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE - 1000);
+    CHECK(ovl_scratch_acquire(OVL_WINDOW_SIZE, &len) == NULL);
+    p = ovl_scratch_acquire(64, &len);
+    CHECK(p == &fake_window[1000]);
+    CHECK_EQ(len, OVL_WINDOW_SIZE - 1000);
+
+    // 0 is outside the loan; 1 would overwrite it
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+    CHECK(ovl_acquire(1) == NULL);
+    CHECK(ovl_is_resident(0));
+    ovl_scratch_release();
+
+    CHECK(ovl_acquire(1) != NULL);
+    ovl_release(1);
+
+    // 0 and 1 resident: only the top 1 KB is left
+    p = ovl_scratch_acquire(0, &len);
+    CHECK(p == &fake_window[2048]);
+    CHECK_EQ(len, OVL_WINDOW_SIZE - 2048);
+    ovl_scratch_release();
+}
+
+static void test_enter_fault(void)
+{
+    setup(overlap);
+    CHECK(ovl_acquire(0) != NULL);
+
+    // the stub path takes no pin, and reports what it cannot load
+    ovl_enter(1);
+    CHECK_EQ(fake_calls.faults, 1);
+    CHECK_EQ(fake_calls.fault_id, 1);
+    CHECK(!ovl_is_resident(1));
+    ovl_release(0);
+
+    // unpinned 0 gives way
+    ovl_enter(1);
+    CHECK_EQ(fake_calls.faults, 1);
+    CHECK(ovl_is_resident(1));
+    CHECK(!ovl_is_resident(0));
+
+    // and 1 holds no pin of its own
+    ovl_enter(0);
+    CHECK_EQ(fake_calls.faults, 1);
+    CHECK(ovl_is_resident(0));
+}
+
+static void test_prefetch_busy_poll(void)
+{
+    const ovl_desc_t *d;
+
+    setup(apart);
+    d = ovl_get_desc(0);
+    fake_dma_script(3, OVL_DMA_DONE);
+    CHECK(ovl_prefetch(0));
+    CHECK_EQ(fake_calls.dma_starts, 1);
+    CHECK_EQ(ovl_get_stats(0)->prefetches, 1);
+
+    // each non-blocking call polls once and leaves it in flight
+    CHECK(!ovl_is_resident(0));
+    CHECK(!fake_in_window(d));
+    CHECK(ovl_prefetch(0));             // already on its way
+    CHECK(!ovl_prefetch(1));            // the channel is taken
+    CHECK_EQ(fake_calls.dma_starts, 1);
+    CHECK_EQ(fake_calls.dma_polls, 3);
+
+    ovl_wait(0);
+    CHECK_EQ(fake_calls.dma_polls, 4);
+    CHECK(ovl_is_resident(0));
+    CHECK(fake_in_window(d));
+    ovl_wait(0);                        // nothing left to wait for
+    CHECK_EQ(fake_calls.dma_polls, 4);
+
+    CHECK(ovl_acquire(0) != NULL);
+    CHECK_EQ(ovl_get_stats(0)->hits, 1);
+    CHECK_EQ(ovl_get_stats(0)->loads, 1);
+    CHECK_EQ(fake_calls.copies, 0);
+    ovl_release(0);
+
+    // the channel is free again
+    CHECK(ovl_prefetch(1));
+    ovl_wait(1);
+    CHECK(ovl_is_resident(1));
+}
+
+static void test_dma_error_cpu_fallback(void)
+{
+    setup(apart);
+    fake_dma_script(1, OVL_DMA_ERROR);
+    CHECK(ovl_prefetch(0));
+
+    // the acquire waits out the transfer and redoes it with the CPU
+    CHECK(ovl_acquire(0) == &fake_window[0]);
+    CHECK_EQ(fake_calls.dma_polls, 2);
+    CHECK_EQ(fake_calls.copies, 1);
+    CHECK_EQ(ovl_get_stats(0)->crc_errors, 1);
+    CHECK_EQ(ovl_get_stats(0)->loads, 1);
+    CHECK(fake_in_window(ovl_get_desc(0)));
+    ovl_release(0);
+}
+
+static void test_dma_error_unclaim(void)
+{
+    const ovl_desc_t *d;
+
+    setup(overlap);
+    d = ovl_get_desc(0);
+    fake_flash[d->lma - fake_flash + 100] ^= 0x40;  // damaged image
+    fake_dma_script(0, OVL_DMA_ERROR);
+    CHECK(ovl_prefetch(0));
+    ovl_wait(0);
+
+    // both copies failed the CRC; the slots are free again
+    CHECK_EQ(fake_calls.copies, 1);
+    CHECK_EQ(ovl_get_stats(0)->crc_errors, 2);
+    CHECK(!ovl_is_resident(0));
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+    CHECK(ovl_acquire(0) == NULL);
+    CHECK_EQ(ovl_get_stats(0)->crc_errors, 3);
+
+    // 1 overlaps 0's slots and loads without waiting for anything
+    CHECK(ovl_acquire(1) != NULL);
+    CHECK_EQ(ovl_get_stats(0)->evictions, 0);
+    ovl_release(1);
+}
+
+static void test_make_room_waits_for_dma(void)
+{
+    setup(overlap);
+    fake_dma_script(5, OVL_DMA_DONE);
+    CHECK(ovl_prefetch(0));
+
+    // 1 needs slots 2..3, which 0 is still arriving in
+    CHECK(ovl_acquire(1) == &fake_window[512]);
+    CHECK_EQ(fake_calls.dma_polls, 6);
+    CHECK_EQ(ovl_get_stats(0)->evictions, 1);
+
+    // nothing is left in flight to land on top of 1 afterwards
+    ovl_wait(0);
+    CHECK_EQ(fake_calls.dma_polls, 6);
+    CHECK(fake_in_window(ovl_get_desc(1)));
+    CHECK(!ovl_is_resident(0));
+    ovl_release(1);
+}
+
+int main(void)
+{
+    RUN(test_init_bad_magic);
+    RUN(test_acquire_miss_then_hit);
+    RUN(test_acquire_pinned_occupant);
+    RUN(test_make_room_evicts_overlaps);
+    RUN(test_scratch_overlaps_overlay);
+    RUN(test_enter_fault);
+    RUN(test_prefetch_busy_poll);
+    RUN(test_dma_error_cpu_fallback);
+    RUN(test_dma_error_unclaim);
+    RUN(test_make_room_waits_for_dma);
+    return test_report("test_overlay");
+}
@@ -0,0 +1,236 @@
+#include <string.h>
+
+#include "ovl_fake_port.h"
+#include "ovl_image.h"
+#include "test.h"
+
+/*
+ * Image store (ovl_store.c) and the CRC checks of the manager, on a
+ * table packed by tools/ovlpack.py (see ovlimage.py): the C checksums
+ * must agree with the stm32_crc() values the packer recorded.
+ */
+
+static union {
+    ovl_table_t table;
+    uint8_t bytes[sizeof(ovl_table_t) + OVL_COUNT * sizeof(ovl_desc_t) + 64 * 4];
+} packed;
+
+static uint32_t le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/*
+ * Put a packed table in fake flash and rebuild its descriptors with
+ * host pointers: stored images at the same offsets from the table, run
+ * addresses at the same offsets in the fake window.
+ */
+static ovl_table_t *load_image(const uint8_t *image, size_t len)
+{
+    ovl_table_t *t = &packed.table;
+    const uint8_t *p = image;
+    uint32_t *list;
+
+    fake_reset();
+    memcpy(fake_flash, image, len);
+    memset(&packed, 0, sizeof(packed));
+
+    t->magic = le32(p);
+    t->count = le32(p + 4);
+    t->entries = le32(p + 8);
+    p += 12;
+    for (unsigned id = 0; id < t->count && id < OVL_COUNT; id++, p += 32) {
+        ovl_desc_t *d = &t->desc[id];
+
+        d->id = le32(p);
+        d->method = le32(p + 4);
+        d->lma = fake_flash + (le32(p + 8) - OVL_IMAGE_BASE);
+        d->vma = fake_window + (le32(p + 12) - OVL_WINDOW_BASE);
+        d->size = le32(p + 16);
+        d->packed_size = le32(p + 20);
+        d->crc = le32(p + 24);
+        d->entry_first = (uint16_t)(p[28] | p[29] << 8);
+        d->entry_count = (uint16_t)(p[30] | p[31] << 8);
+    }
+    list = (uint32_t *)&t->desc[t->count];
+    for (unsigned i = 0; i < t->entries && i < 64; i++, p += 4) {
+        list[i] = le32(p);
+    }
+    return t;
+}
+
+static ovl_table_t *load_table(void)
+{
+    return load_image(ovl_image, sizeof(ovl_image));
+}
+
+static void setup(void)
+{
+    ovl_init(load_table(), fake_window);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_crc_matches_packer(void)
+{
+    uint8_t buf[256];
+
+    for (size_t i = 0; i < sizeof(crc_vectors) / sizeof(crc_vectors[0]); i++) {
+        size_t len = crc_vectors[i].len;
+
+        CHECK_EQ(ovl_crc_image(crc_vectors[i].data, len), crc_vectors[i].crc);
+
+        // the checked copy feeds the unit the same words
+        ovl_copy_words_crc(buf, crc_vectors[i].data, len, ovl_port_crc_begin());
+        CHECK_EQ(ovl_port_crc_end(), crc_vectors[i].crc);
+        CHECK(memcmp(buf, crc_vectors[i].data, len) == 0);
+    }
+}
+
+static void test_packed_images_load(void)
+{
+    const ovl_table_t *t = load_table();
+
+    CHECK_EQ(t->magic, OVL_TABLE_MAGIC);
+    CHECK_EQ(t->count, 2);
+    CHECK_EQ(t->desc[0].method, OVL_PACK_RAW);
+    CHECK_EQ(t->desc[1].method, OVL_PACK_LZ4);
+
+    // decode or copy each one and check it against the packer's CRC
+    for (unsigned id = 0; id < t->count; id++) {
+        const ovl_desc_t *d = &t->desc[id];
+
+        CHECK(d->packed_size <= d->size);
+        CHECK_EQ(ovl_image_load(d), 0);
+        CHECK_EQ(ovl_crc_image(d->vma, d->size), d->crc);
+        CHECK_EQ(ovl_port_check(d), 0);
+    }
+
+    // and through the manager, with the entry list behind the table
+    setup();
+    for (ovl_id_t id = 0; id < 2; id++) {
+        const ovl_desc_t *d = ovl_get_desc(id);
+
+        CHECK(ovl_acquire(id) == d->vma);
+        ovl_release(id);
+        CHECK_EQ((uintptr_t)ovl_entry(id, 0),
+                 OVL_WINDOW_BASE + (uint32_t)(d->vma - fake_window) + 1u);
+        CHECK(ovl_entry(id, d->entry_count) == NULL);
+        CHECK_EQ(ovl_get_stats(id)->crc_errors, 0);
+    }
+    CHECK(ovl_is_resident(0));
+    CHECK(ovl_is_resident(1));          // the other bank
+}
+
+static void test_crc_mismatch_retry_unclaim(void)
+{
+    const ovl_desc_t *d;
+
+    setup();
+    d = ovl_get_desc(0);
+    fake_flash[d->lma - fake_flash + d->size - 1] ^= 0x01;
+
+    // DMA lands, fails the check, the CPU retries and fails as well
+    CHECK(ovl_prefetch(0));
+    ovl_wait(0);
+    CHECK_EQ(fake_calls.dma_starts, 1);
+    CHECK_EQ(fake_calls.copies, 1);
+    CHECK_EQ(ovl_get_stats(0)->crc_errors, 2);
+    CHECK(!ovl_is_resident(0));
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+
+    // a plain acquire fails on the CRC and claims nothing either
+    CHECK(ovl_acquire(0) == NULL);
+    CHECK_EQ(ovl_get_stats(0)->crc_errors, 3);
+    CHECK_EQ(ovl_get_stats(0)->loads, 1);      // the prefetch only
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+}
+
+static void test_lz4_mismatch(void)
+{
+    const ovl_desc_t *d;
+
+    setup();
+    d = ovl_get_desc(1);
+
+    // the stream ends in literals: still well-formed, but the CRC is off
+    fake_flash[d->lma - fake_flash + d->packed_size - 1] ^= 0x80;
+    CHECK_EQ(ovl_image_load(d), -1);
+    CHECK(ovl_acquire(1) == NULL);
+    CHECK_EQ(ovl_get_stats(1)->crc_errors, 1);
+
+    // decoded at prefetch time, reported as a DMA error, then the CPU
+    CHECK(ovl_prefetch(1));
+    ovl_wait(1);
+    CHECK_EQ(ovl_get_stats(1)->crc_errors, 3);
+    CHECK(!ovl_is_resident(1));
+
+    // a truncated stream is malformed
+    packed.table.desc[1].packed_size -= 3;
+    CHECK_EQ(ovl_image_load(d), -1);
+}
+
+static void test_raw_names_prefetch_by_dma(void)
+{
+    const ovl_desc_t *d;
+
+    // packed: the prefetch decodes with the CPU before it returns
+    setup();
+    CHECK(ovl_prefetch(1));
+    CHECK_EQ(fake_calls.copies, 1);
+    ovl_wait(1);
+    CHECK(ovl_is_resident(1));
+
+    // forced raw: the prefetch only starts the DMA
+    ovl_init(load_image(ovl_image_raw, sizeof(ovl_image_raw)), fake_window);
+    d = ovl_get_desc(1);
+    CHECK_EQ(d->method, OVL_PACK_RAW);
+    CHECK_EQ(d->packed_size, d->size);
+    CHECK_EQ(ovl_get_desc(0)->method, OVL_PACK_RAW);
+
+    fake_dma_script(3, OVL_DMA_DONE);
+    CHECK(ovl_prefetch(1));
+    CHECK_EQ(fake_calls.dma_starts, 1);
+    CHECK_EQ(fake_calls.copies, 0);
+    CHECK(!ovl_is_resident(1));         // still on its way
+    ovl_wait(1);
+    CHECK_EQ(fake_calls.copies, 0);
+    CHECK(ovl_is_resident(1));
+    CHECK_EQ(ovl_get_stats(1)->crc_errors, 0);
+    CHECK_EQ(ovl_crc_image(d->vma, d->size), d->crc);
+}
+
+static void test_verify_drops_damaged_copy(void)
+{
+    const ovl_desc_t *d;
+
+    setup();
+    d = ovl_get_desc(0);
+    CHECK(ovl_acquire(0) != NULL);
+    ovl_release(0);
+    CHECK(ovl_verify(0));
+
+    d->vma[10] ^= 0x20;
+    CHECK(!ovl_verify(0));
+    CHECK_EQ(ovl_get_stats(0)->crc_errors, 1);
+    CHECK(!ovl_is_resident(0));
+
+    // the next acquire loads it again
+    CHECK(ovl_acquire(0) != NULL);
+    CHECK_EQ(ovl_get_stats(0)->loads, 2);
+    CHECK(ovl_verify(0));
+    ovl_release(0);
+}
+
+int main(void)
+{
+    RUN(test_crc_matches_packer);
+    RUN(test_packed_images_load);
+    RUN(test_crc_mismatch_retry_unclaim);
+    RUN(test_lz4_mismatch);
+    RUN(test_raw_names_prefetch_by_dma);
+    RUN(test_verify_drops_damaged_copy);
+    return test_report("test_ovl_store");
+}
@@ -0,0 +1,118 @@
+#include "test.h"
+#include "key_util.h"
+
+/*
+ * br_rsa_i15_pkcs1_vrfy() on the signatures rsakey.py --sign makes with
+ * data/rsa_priv.pem (SHA-256 over the pattern message, byte i is
+ * i & 0xFF), and what it has to turn down: any flipped signature byte,
+ * a hash of another message or of another length or algorithm, and,
+ * on the encoded message the public operation recovers, any change to
+ * the padding or the DigestInfo in front of the hash.
+ */
+
+#define SIG_MAX  (BR_RSA_I15_PUBCTX_MAX_BITS / 8)
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_signatures_verify(void)
+{
+    unsigned char hash[32], got[32];
+
+    for (size_t k = 0; k < KEY_SIG_COUNT; k++) {
+        const rsakey_sig *s = &test_key_sig[k];
+
+        key_pattern_hash(hash, s->msg_len);
+        memset(got, 0, sizeof(got));
+        CHECK_EQ(br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, BR_HASH_OID_SHA256,
+                                       sizeof(got), &key_pk, got), 1);
+        CHECK(memcmp(got, hash, sizeof(hash)) == 0);
+    }
+}
+
+static void test_flipped_byte(void)
+{
+    unsigned char sig[SIG_MAX], got[32];
+
+    for (size_t k = 0; k < KEY_SIG_COUNT; k++) {
+        const rsakey_sig *s = &test_key_sig[k];
+
+        for (size_t u = 0; u < s->sig_len; u += 1 + u / 3) {
+            memcpy(sig, s->sig, s->sig_len);
+            sig[u] ^= (unsigned char)(1u << (u % 8));
+            CHECK_EQ(br_rsa_i15_pkcs1_vrfy(sig, s->sig_len, BR_HASH_OID_SHA256,
+                                           sizeof(got), &key_pk, got), 0);
+        }
+    }
+}
+
+static void test_wrong_hash(void)
+{
+    unsigned char hash[32], got[32];
+
+    for (size_t k = 0; k < KEY_SIG_COUNT; k++) {
+        const rsakey_sig *s = &test_key_sig[k];
+
+        // the hash of the next signed message: the padding is fine, the
+        // caller's comparison fails
+        key_pattern_hash(hash, test_key_sig[(k + 1) % KEY_SIG_COUNT].msg_len);
+        CHECK_EQ(br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, BR_HASH_OID_SHA256,
+                                       sizeof(got), &key_pk, got), 1);
+        CHECK(memcmp(got, hash, sizeof(hash)) != 0);
+
+        // another algorithm or hash length does not match the DigestInfo
+        CHECK_EQ(br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, BR_HASH_OID_SHA224,
+                                       28, &key_pk, got), 0);
+        CHECK_EQ(br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, BR_HASH_OID_SHA1,
+                                       20, &key_pk, got), 0);
+        CHECK_EQ(br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, BR_HASH_OID_SHA256,
+                                       28, &key_pk, got), 0);
+        CHECK_EQ(br_rsa_i15_pkcs1_vrfy(s->sig, s->sig_len, NULL,
+                                       sizeof(got), &key_pk, got), 0);
+    }
+}
+
+// 00 01 FF .. FF 00 | 30 31 30 0D 06 09 <OID> 05 00 04 20 | hash: every
+// byte in front of the hash is fixed by the format
+static void test_bad_digest_info(void)
+{
+    const rsakey_sig *s = &test_key_sig[0];
+    unsigned char em[SIG_MAX], bad[SIG_MAX], got[32];
+    size_t len = s->sig_len;
+
+    memcpy(em, s->sig, len);
+    CHECK_EQ(br_rsa_i15_public(em, len, &key_pk), 1);
+    CHECK_EQ(br_rsa_pkcs1_sig_unpad(em, len, BR_HASH_OID_SHA256, 32, got), 1);
+    CHECK(memcmp(em + len - 52, "\x00\x30\x31\x30\x0D\x06\x09", 7) == 0);
+
+    for (size_t u = 0; u < len - 32; u++) {
+        memcpy(bad, em, len);
+        bad[u] ^= 0x01;
+        CHECK_EQ(br_rsa_pkcs1_sig_unpad(bad, len, BR_HASH_OID_SHA256, 32, got), 0);
+        bad[u] ^= 0x81;
+        CHECK_EQ(br_rsa_pkcs1_sig_unpad(bad, len, BR_HASH_OID_SHA256, 32, got), 0);
+    }
+
+    // without the NULL parameters the encoding is still accepted
+    bad[0] = 0x00;
+    bad[1] = 0x01;
+    memset(bad + 2, 0xFF, len - 52);
+    memcpy(bad + len - 50, "\x00\x30\x2F\x30\x0B\x06\x09", 7);
+    memcpy(bad + len - 43, BR_HASH_OID_SHA256 + 1, 9);
+    memcpy(bad + len - 34, "\x04\x20", 2);
+    memcpy(bad + len - 32, em + len - 32, 32);
+    CHECK_EQ(br_rsa_pkcs1_sig_unpad(bad, len, BR_HASH_OID_SHA256, 32, got), 1);
+    CHECK(memcmp(got, em + len - 32, 32) == 0);
+}
+
+int main(void)
+{
+    i15_test_init(0x9C5A0024U);
+    key_init();
+    RUN(test_signatures_verify);
+    RUN(test_flipped_byte);
+    RUN(test_wrong_hash);
+    RUN(test_bad_digest_info);
+    return test_report("test_pkcs1");
+}
@@ -0,0 +1,167 @@
+#include "test.h"
+#include "key_util.h"
+
+/*
+ * br_rsa_i15_pss_vrfy() on the PSS signatures rsakey.py --sign makes
+ * with data/rsa_priv.pem (SHA-256, MGF1-SHA-256, PSS_SALT_LEN bytes of
+ * salt), and what it has to turn down: flipped signature bytes, another
+ * message, salt length or MGF1 hash, and, on the encoded message the
+ * public operation recovers, a bad 0xBC trailer, bits set above the
+ * modulus length and any change to the masked DB or to H. br_mgf1_xor()
+ * is checked against MGF1 spelled out with SHA-256.
+ */
+
+#define SIG_MAX  (BR_RSA_I15_PUBCTX_MAX_BITS / 8)
+
+#define SALT_LEN  (test_key_sig[0].salt_len)
+
+static unsigned char em[SIG_MAX];
+static size_t em_len;
+
+/* The encoded message of the first signature, as the public key gives it */
+static void recover_em(void)
+{
+    const rsakey_sig *s = &test_key_sig[0];
+
+    em_len = s->pss_len;
+    memcpy(em, s->pss, em_len);
+    CHECK_EQ(br_rsa_i15_public(em, em_len, &key_pk), 1);
+}
+
+/* br_rsa_pss_sig_unpad() on em[] with byte u xored with mask */
+static uint32_t unpad_changed(size_t u, unsigned char mask, size_t salt_len)
+{
+    unsigned char hash[32], x[SIG_MAX];
+
+    key_pattern_hash(hash, test_key_sig[0].msg_len);
+    memcpy(x, em, em_len);
+    x[u] ^= mask;
+    return br_rsa_pss_sig_unpad(&br_sha256_vtable, &br_sha256_vtable,
+                                hash, salt_len, &key_pk, x);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_mgf1(void)
+{
+    unsigned char seed[32], got[100], want[128], block[36];
+    br_sha256_context sc;
+
+    i15_random_bytes(seed, sizeof(seed));
+    memcpy(block, seed, sizeof(seed));
+    for (unsigned c = 0; c < 4; c++) {
+        br_enc32be(block + 32, c);
+        br_sha256_init(&sc);
+        br_sha256_update(&sc, block, sizeof(block));
+        br_sha256_out(&sc, want + 32 * c);
+    }
+    for (size_t len = 1; len <= sizeof(got); len += 3) {
+        for (size_t u = 0; u < len; u++) {
+            got[u] = (unsigned char)u;
+        }
+        br_mgf1_xor(got, len, &br_sha256_vtable, seed, sizeof(seed));
+        for (size_t u = 0; u < len; u++) {
+            got[u] ^= (unsigned char)u;
+        }
+        CHECK(memcmp(got, want, len) == 0);
+    }
+}
+
+static void test_signatures_verify(void)
+{
+    unsigned char hash[32];
+
+    for (size_t k = 0; k < KEY_SIG_COUNT; k++) {
+        const rsakey_sig *s = &test_key_sig[k];
+
+        key_pattern_hash(hash, s->msg_len);
+        CHECK_EQ(br_rsa_i15_pss_vrfy(s->pss, s->pss_len, &br_sha256_vtable,
+                                     &br_sha256_vtable, hash, s->salt_len,
+                                     &key_pk), 1);
+    }
+}
+
+static void test_wrong_input(void)
+{
+    unsigned char hash[32], sig[SIG_MAX];
+
+    for (size_t k = 0; k < KEY_SIG_COUNT; k++) {
+        const rsakey_sig *s = &test_key_sig[k];
+
+        // another message
+        key_pattern_hash(hash, test_key_sig[(k + 1) % KEY_SIG_COUNT].msg_len);
+        CHECK_EQ(br_rsa_i15_pss_vrfy(s->pss, s->pss_len, &br_sha256_vtable,
+                                     &br_sha256_vtable, hash, s->salt_len,
+                                     &key_pk), 0);
+
+        // flipped signature bytes
+        key_pattern_hash(hash, s->msg_len);
+        for (size_t u = 0; u < s->pss_len; u += 1 + u / 3) {
+            memcpy(sig, s->pss, s->pss_len);
+            sig[u] ^= (unsigned char)(0x80u >> (u % 8));
+            CHECK_EQ(br_rsa_i15_pss_vrfy(sig, s->pss_len, &br_sha256_vtable,
+                                         &br_sha256_vtable, hash, s->salt_len,
+                                         &key_pk), 0);
+        }
+
+        // the mask generated with another hash
+        CHECK_EQ(br_rsa_i15_pss_vrfy(s->pss, s->pss_len, &br_sha256_vtable,
+                                     &br_sha224_vtable, hash, s->salt_len,
+                                     &key_pk), 0);
+    }
+}
+
+static void test_salt_length(void)
+{
+    recover_em();
+    CHECK_EQ(unpad_changed(0, 0, SALT_LEN), 1);
+    CHECK_EQ(unpad_changed(0, 0, 0), 0);
+    CHECK_EQ(unpad_changed(0, 0, SALT_LEN - 1), 0);
+    CHECK_EQ(unpad_changed(0, 0, SALT_LEN + 1), 0);
+    CHECK_EQ(unpad_changed(0, 0, em_len - 33), 0);
+    CHECK_EQ(unpad_changed(0, 0, em_len), 0);
+}
+
+static void test_trailer_and_top_bits(void)
+{
+    uint16_t hdr = test_key_pub.m[0];
+    unsigned top;
+
+    // emBits is one less than the modulus length
+    recover_em();
+    top = 8 * (unsigned)em_len - ((hdr >> 4) * 15u + (hdr & 15u) - 1);
+    CHECK_EQ(em[em_len - 1], 0xBC);
+    CHECK_EQ(unpad_changed(em_len - 1, 0x01, SALT_LEN), 0);
+    CHECK_EQ(unpad_changed(em_len - 1, 0xBC, SALT_LEN), 0);
+    CHECK_EQ(unpad_changed(em_len - 1, 0x80, SALT_LEN), 0);
+
+    // the bits at and above the modulus length must be clear
+    CHECK_EQ(em[0] >> (8 - top), 0);
+    for (unsigned b = 0; b < top; b++) {
+        CHECK_EQ(unpad_changed(0, (unsigned char)(0x80u >> b), SALT_LEN), 0);
+    }
+}
+
+// every byte of maskedDB and H takes part in the check
+static void test_corrupted_db(void)
+{
+    recover_em();
+    for (size_t u = 0; u < em_len - 1; u++) {
+        CHECK_EQ(unpad_changed(u, 0x01, SALT_LEN), 0);
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x9C5A0025U);
+    key_init();
+    RUN(test_mgf1);
+    RUN(test_signatures_verify);
+    RUN(test_wrong_input);
+    RUN(test_salt_length);
+    RUN(test_trailer_and_top_bits);
+    RUN(test_corrupted_db);
+    return test_report("test_pss");
+}
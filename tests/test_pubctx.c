@@ -0,0 +1,181 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * br_rsa_i15_public_ctx() on a context from br_rsa_i15_pubctx_init()
+ * against the reference br_rsa_i15_public() on the same key, with the
+ * temporaries in the window and on the stack; and the keys and inputs
+ * either of them refuses.
+ */
+
+#define ROUNDS  8
+
+static unsigned char n[I15_TEST_BITS / 8 + 2];
+static br_rsa_public_key pk;
+
+#if BR_I15_FIXED_BITS > BR_RSA_I15_PUBCTX_MAX_BITS
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+// no key of the one size the kernels take fits the context
+static void test_pubctx_fixed_too_large(void)
+{
+    static unsigned char e[] = { 0x01, 0x00, 0x01 };
+    uint16_t m[I15_WORDS];
+    br_rsa_i15_pubctx ctx;
+
+    i15_test_init(0x9C7C0300U);
+    pk.n = n;
+    pk.nlen = i15_random_mod(m, n, I15_TEST_BITS);
+    pk.e = e;
+    pk.elen = sizeof(e);
+    CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 0);
+}
+
+#else
+
+/* Random key of at most BR_RSA_I15_PUBCTX_MAX_BITS, exponent by round */
+static void random_key(unsigned round)
+{
+    static unsigned char e3[] = { 0x03 };
+    static unsigned char e65537[] = { 0x01, 0x00, 0x01 };
+    static unsigned char e_long[] = { 0x00, 0xC3, 0x5A, 0x01, 0x97 };
+    uint16_t m[I15_WORDS];
+    unsigned bits;
+
+    do {
+        bits = i15_test_bits(round++);
+    } while (bits > BR_RSA_I15_PUBCTX_MAX_BITS);
+    pk.n = n;
+    pk.nlen = i15_random_mod(m, n, bits);
+    switch (round % 3) {
+    case 0:
+        pk.e = e3;
+        pk.elen = sizeof(e3);
+        break;
+    case 1:
+        pk.e = e65537;
+        pk.elen = sizeof(e65537);
+        break;
+    default:
+        pk.e = e_long;
+        pk.elen = sizeof(e_long);
+        break;
+    }
+}
+
+/* Random x < n and its reference result in want[] */
+static void random_input(unsigned char *x, unsigned char *want)
+{
+    i15_random_bytes(x, pk.nlen);
+    x[0] = n[0] >> 1;
+    memcpy(want, x, pk.nlen);
+    CHECK_EQ(ref_br_rsa_i15_public(want, pk.nlen, &pk), 1);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_public_ctx(void)
+{
+    unsigned char x[sizeof(n)], want[sizeof(n)];
+    br_rsa_i15_pubctx ctx;
+    size_t len;
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_test_init(0x9C7C0000U + r);
+        random_key(r);
+        CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 1);
+
+        // temporaries in the window
+        random_input(x, want);
+        CHECK_EQ(br_rsa_i15_public_ctx(x, pk.nlen, &ctx), 1);
+        CHECK(memcmp(x, want, pk.nlen) == 0);
+        CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+
+        // and on the stack while somebody else holds the arena
+        random_input(x, want);
+        CHECK(ovl_scratch_acquire(0, &len) != NULL);
+        CHECK_EQ(br_rsa_i15_public_ctx(x, pk.nlen, &ctx), 1);
+        CHECK(memcmp(x, want, pk.nlen) == 0);
+        ovl_scratch_release();
+
+        // the context is only read
+        random_input(x, want);
+        CHECK_EQ(br_rsa_i15_public_ctx(x, pk.nlen, &ctx), 1);
+        CHECK(memcmp(x, want, pk.nlen) == 0);
+    }
+}
+
+static void test_pubctx_leading_zeros(void)
+{
+    unsigned char x[sizeof(n)], want[sizeof(n)];
+    br_rsa_i15_pubctx ctx;
+
+    i15_test_init(0x9C7C0100U);
+    random_key(1);
+
+    // two zero bytes in front of the modulus are skipped
+    memmove(n + 2, n, pk.nlen);
+    n[0] = n[1] = 0;
+    pk.nlen += 2;
+    CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 1);
+    pk.n = n + 2;
+    pk.nlen -= 2;
+
+    random_input(x, want);
+    CHECK_EQ(br_rsa_i15_public_ctx(x, pk.nlen + 2, &ctx), 0);
+    CHECK_EQ(br_rsa_i15_public_ctx(x, pk.nlen, &ctx), 1);
+    CHECK(memcmp(x, want, pk.nlen) == 0);
+}
+
+static void test_pubctx_rejects(void)
+{
+    unsigned char x[sizeof(n)];
+    br_rsa_i15_pubctx ctx;
+
+    i15_test_init(0x9C7C0200U);
+    random_key(0);
+
+    // x == n is out of range
+    CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 1);
+    memcpy(x, n, pk.nlen);
+    CHECK_EQ(br_rsa_i15_public_ctx(x, pk.nlen, &ctx), 0);
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+
+    // an even modulus
+    n[pk.nlen - 1] &= 0xFE;
+    CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 0);
+    n[pk.nlen - 1] |= 1;
+
+    // a zero one
+    memset(n, 0, pk.nlen);
+    CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 0);
+
+#if !BR_I15_FIXED_BITS && BR_RSA_I15_PUBCTX_MAX_BITS < BR_MAX_RSA_SIZE
+    // one that br_rsa_i15_public() takes but the context cannot hold
+    {
+        uint16_t m[I15_WORDS];
+
+        pk.nlen = i15_random_mod(m, n, BR_RSA_I15_PUBCTX_MAX_BITS + 8);
+        CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 0);
+    }
+#endif
+}
+
+#endif /* BR_I15_FIXED_BITS > BR_RSA_I15_PUBCTX_MAX_BITS */
+
+int main(void)
+{
+#if BR_I15_FIXED_BITS > BR_RSA_I15_PUBCTX_MAX_BITS
+    RUN(test_pubctx_fixed_too_large);
+#else
+    RUN(test_public_ctx);
+    RUN(test_pubctx_leading_zeros);
+    RUN(test_pubctx_rejects);
+#endif
+    return test_report("test_pubctx");
+}
@@ -0,0 +1,127 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * br_rsa_i15_public() with its temporaries borrowed from the overlay
+ * window (BR_SCRATCH_ACQUIRE=ovl_scratch_acquire) or, when the window
+ * has no room, on the stack: same results as the reference either way,
+ * and the loan is always returned.
+ */
+
+#define ROUNDS  8
+
+static unsigned char n[I15_TEST_BITS / 8];
+static br_rsa_public_key pk;
+
+static void random_key(unsigned round)
+{
+    static unsigned char e[] = { 0x01, 0x00, 0x01 };
+    uint16_t m[I15_WORDS];
+
+    pk.n = n;
+    pk.nlen = i15_random_mod(m, n, i15_test_bits(round));
+    pk.e = e;
+    pk.elen = sizeof(e);
+}
+
+/* Random x < n, its reference result in want[], the window poisoned */
+static void random_input(unsigned char *x, unsigned char *want)
+{
+    i15_random_bytes(x, pk.nlen);
+    x[0] = n[0] >> 1;
+    memcpy(want, x, pk.nlen);
+    CHECK_EQ(ref_br_rsa_i15_public(want, pk.nlen, &pk), 1);
+    memset(fake_window, 0xA5, sizeof(fake_window));
+}
+
+static int window_poisoned(size_t from)
+{
+    for (size_t i = from; i < sizeof(fake_window); i++) {
+        if (fake_window[i] != 0xA5) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_public_in_window(void)
+{
+    unsigned char x[sizeof(n)], want[sizeof(n)];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_test_init(0x5C4A7C00U + r);
+        random_key(r);
+        random_input(x, want);
+
+        CHECK_EQ(br_rsa_i15_public(x, pk.nlen, &pk), 1);
+        CHECK(memcmp(x, want, pk.nlen) == 0);
+        CHECK(!window_poisoned(0));         // the temporaries went there
+        CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+    }
+}
+
+static void test_public_on_stack(void)
+{
+    unsigned char x[sizeof(n)], want[sizeof(n)];
+    size_t len;
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_test_init(0x5C4A7D00U + r);
+        random_key(r);
+        random_input(x, want);
+
+        // somebody else holds the arena
+        CHECK(ovl_scratch_acquire(0, &len) != NULL);
+        CHECK_EQ(br_rsa_i15_public(x, pk.nlen, &pk), 1);
+        CHECK(memcmp(x, want, pk.nlen) == 0);
+        CHECK(window_poisoned(0));
+        ovl_scratch_release();
+    }
+}
+
+static void test_public_window_too_small(void)
+{
+    static const fake_overlay_t big[] = { { 0, OVL_WINDOW_SIZE - 256 } };
+    unsigned char x[sizeof(n)], want[sizeof(n)];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_test_init(0x5C4A7E00U + r);
+        random_key(0);                      // the largest size
+        ovl_init(fake_table(big, 1), fake_window);
+        CHECK(ovl_acquire(0) != NULL);
+        ovl_release(0);
+        random_input(x, want);
+
+        // 256 bytes behind the overlay are not enough
+        CHECK_EQ(br_rsa_i15_public(x, pk.nlen, &pk), 1);
+        CHECK(memcmp(x, want, pk.nlen) == 0);
+        CHECK(window_poisoned(0));
+        CHECK_EQ(ovl_scratch_avail(), 256);
+    }
+}
+
+static void test_public_rejects_and_releases(void)
+{
+    unsigned char x[sizeof(n)];
+
+    i15_test_init(0x5C4A7F00U);
+    random_key(0);
+
+    // x == n is out of range; the loan is still returned
+    memcpy(x, n, pk.nlen);
+    CHECK_EQ(br_rsa_i15_public(x, pk.nlen, &pk), 0);
+    CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+}
+
+int main(void)
+{
+    RUN(test_public_in_window);
+    RUN(test_public_on_stack);
+    RUN(test_public_window_too_small);
+    RUN(test_public_rejects_and_releases);
+    return test_report("test_rsa_scratch");
+}
@@ -0,0 +1,140 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * br_rsa_i15_public_ws() with a caller's workspace: the length that
+ * br_rsa_i15_public_ws_len() reports, results equal to the reference
+ * in a workspace of exactly that length at either 16-bit alignment,
+ * nothing written past it or into the overlay window, and refusal of
+ * a workspace one byte short.
+ */
+
+#define ROUNDS  8
+
+static unsigned char n[I15_TEST_BITS / 8];
+static br_rsa_public_key pk;
+static union {
+    uint32_t align;
+    unsigned char bytes[4096];
+} ws;
+
+static void random_key(unsigned round)
+{
+    static unsigned char e[] = { 0x01, 0x00, 0x01 };
+    uint16_t m[I15_WORDS];
+
+    pk.n = n;
+    pk.nlen = i15_random_mod(m, n, i15_test_bits(round));
+    pk.e = e;
+    pk.elen = sizeof(e);
+}
+
+/* Expected workspace: 1 + 4 words per integer, of an even word count */
+static size_t expected_len(void)
+{
+    uint16_t m[I15_WORDS];
+    size_t fwlen;
+
+    br_i15_decode(m, n, pk.nlen);
+    fwlen = 1 + ((m[0] + 15) >> 4);
+    fwlen += fwlen & 1;
+    return (1 + 4 * fwlen) * sizeof(uint16_t);
+}
+
+static int untouched(const unsigned char *p, size_t len, unsigned char v)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (p[i] != v) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_ws_len(void)
+{
+    unsigned char zero[8] = { 0 };
+    br_rsa_public_key bad = { zero, sizeof(zero), pk.e, pk.elen };
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_key(r);
+        CHECK_EQ(br_rsa_i15_public_ws_len(&pk), expected_len());
+    }
+
+    // RSA-2048, as the README states
+#if BR_I15_FIXED_BITS ? BR_I15_FIXED_BITS == 2048 : BR_MAX_RSA_SIZE >= 2048
+    {
+        uint16_t m[I15_WORDS];
+
+        pk.nlen = i15_random_mod(m, n, 2048);
+        CHECK_EQ(br_rsa_i15_public_ws_len(&pk), 1106);
+    }
+#endif
+
+    // a key the engine refuses needs none
+    CHECK_EQ(br_rsa_i15_public_ws_len(&bad), 0);
+}
+
+static void test_ws_public(void)
+{
+    unsigned char x[sizeof(n)], want[sizeof(n)];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_key(r);
+        size_t len = br_rsa_i15_public_ws_len(&pk);
+
+        // word-aligned and odd-word-aligned workspaces
+        for (size_t off = 0; off <= 2; off += 2) {
+            i15_random_bytes(x, pk.nlen);
+            x[0] = n[0] >> 1;
+            memcpy(want, x, pk.nlen);
+            CHECK_EQ(ref_br_rsa_i15_public(want, pk.nlen, &pk), 1);
+
+            memset(ws.bytes, 0xA5, sizeof(ws.bytes));
+            memset(fake_window, 0xA5, sizeof(fake_window));
+            CHECK_EQ(br_rsa_i15_public_ws(x, pk.nlen, &pk, ws.bytes + off, len), 1);
+            CHECK(memcmp(x, want, pk.nlen) == 0);
+            CHECK(untouched(ws.bytes + off + len, sizeof(ws.bytes) - off - len, 0xA5));
+            CHECK(untouched(fake_window, sizeof(fake_window), 0xA5));
+            CHECK_EQ(ovl_scratch_avail(), OVL_WINDOW_SIZE);
+        }
+    }
+}
+
+static void test_ws_rejects(void)
+{
+    unsigned char x[sizeof(n)], keep[sizeof(n)];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        random_key(r);
+        size_t len = br_rsa_i15_public_ws_len(&pk);
+
+        i15_random_bytes(x, pk.nlen);
+        x[0] = n[0] >> 1;
+        memcpy(keep, x, pk.nlen);
+
+        // one byte short: refused before anything is written
+        memset(ws.bytes, 0xA5, sizeof(ws.bytes));
+        CHECK_EQ(br_rsa_i15_public_ws(x, pk.nlen, &pk, ws.bytes, len - 1), 0);
+        CHECK(memcmp(x, keep, pk.nlen) == 0);
+        CHECK(untouched(ws.bytes, sizeof(ws.bytes), 0xA5));
+
+        // wrong operand length, and x == n
+        CHECK_EQ(br_rsa_i15_public_ws(x, pk.nlen - 1, &pk, ws.bytes, len), 0);
+        memcpy(x, n, pk.nlen);
+        CHECK_EQ(br_rsa_i15_public_ws(x, pk.nlen, &pk, ws.bytes, len), 0);
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x0A5C0020U);
+    RUN(test_ws_len);
+    RUN(test_ws_public);
+    RUN(test_ws_rejects);
+    return test_report("test_rsa_ws");
+}
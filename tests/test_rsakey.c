@@ -0,0 +1,159 @@
+#include "test.h"
+#include "key_util.h"
+
+/*
+ * The tables tools/rsakey.py compiles from data/rsa_priv.pem: the
+ * public context against what br_rsa_i15_pubctx_init() computes for
+ * the same modulus, and the private one against the reference i15
+ * code (p q = n, Montgomery constants, R^2 mod p and q, iq q = 1 mod p
+ * once iq leaves Montgomery representation, and dp, dq inverting e).
+ */
+
+#define ROUNDS  4
+
+#define PRIV_BYTES  ((BR_RSA_I15_PUBCTX_MAX_BITS + 1) / 2 / 8 + 8)
+
+/* Bit length from an i15 header word */
+static unsigned bit_length(uint16_t hdr)
+{
+    return (hdr >> 4) * 15u + (hdr & 15u);
+}
+
+/* R^2 mod m the slow way: 1 converted to Montgomery form twice */
+static void slow_r2(uint16_t *d, const uint16_t *m)
+{
+    memset(d, 0, ((m[0] + 31) >> 4) * sizeof(*d));
+    d[0] = m[0];
+    d[1] = 1;
+    ref_br_i15_to_monty(d, m);
+    ref_br_i15_to_monty(d, m);
+}
+
+/* x^(e d) = x mod p, for random x below the prime p */
+static void check_exponent(const uint16_t *p, uint16_t p0i,
+                           const unsigned char *d, size_t dlen)
+{
+    uint16_t x[BR_RSA_I15_PRIVCTX_WORDS], y[BR_RSA_I15_PRIVCTX_WORDS];
+    uint16_t t1[BR_RSA_I15_PRIVCTX_WORDS], t2[BR_RSA_I15_PRIVCTX_WORDS];
+    unsigned char buf[PRIV_BYTES];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_random_bytes(buf, sizeof(buf));
+        ref_br_i15_decode_reduce(x, buf, sizeof(buf), p);
+        memcpy(y, x, sizeof(y));
+        ref_br_i15_modpow(y, key_pk.e, key_pk.elen, p, p0i, t1, t2);
+        ref_br_i15_modpow(y, d, dlen, p, p0i, t1, t2);
+        CHECK(i15_equal(y, x));
+    }
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_pub_matches_pubctx_init(void)
+{
+    br_rsa_i15_pubctx ctx;
+    uint16_t m[I15_WORDS];
+
+    key_init();
+    CHECK(key_n[0] != 0);
+    CHECK_EQ(bit_length(test_key_pub.m[0]),
+             8 * (key_pk.nlen - 1) + 32 - __builtin_clz(key_n[0]));
+
+    // the words are canonical: decoding the bytes gives them back
+    br_i15_decode(m, key_n, key_pk.nlen);
+    CHECK(i15_equal(m, test_key_pub.m));
+
+    CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &key_pk), 1);
+    CHECK_EQ(ctx.m0i, test_key_pub.m0i);
+    CHECK(i15_equal(ctx.m, test_key_pub.m));
+    CHECK(i15_equal(ctx.r2, test_key_pub.r2));
+    CHECK_EQ(ctx.nlen, test_key_pub.nlen);
+    CHECK(ctx.e == test_key_pub.e && ctx.elen == test_key_pub.elen);
+
+    // R^2 and m0i as the reference would derive them
+    slow_r2(m, test_key_pub.m);
+    CHECK(i15_equal(m, test_key_pub.r2));
+    CHECK_EQ(ref_br_i15_ninv15(test_key_pub.m[1]), test_key_pub.m0i);
+}
+
+static void test_pub_public_ctx(void)
+{
+    unsigned char x[sizeof(key_n)], want[sizeof(key_n)];
+
+    key_init();
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        i15_random_bytes(x, key_pk.nlen);
+        x[0] = key_n[0] >> 1;
+        memcpy(want, x, key_pk.nlen);
+        CHECK_EQ(ref_br_rsa_i15_public(want, key_pk.nlen, &key_pk), 1);
+        CHECK_EQ(br_rsa_i15_public_ctx(x, key_pk.nlen, &test_key_pub), 1);
+        CHECK(memcmp(x, want, key_pk.nlen) == 0);
+    }
+}
+
+static void test_priv_factors(void)
+{
+    const br_rsa_i15_privctx *sk = &test_key_priv;
+    uint16_t d[2 * BR_RSA_I15_PRIVCTX_WORDS];
+    unsigned char pq[sizeof(key_n) + 1], want[sizeof(key_n) + 1];
+
+    key_init();
+    CHECK_EQ(sk->n_bitlen, bit_length(test_key_pub.m[0]));
+
+    // p q = n
+    memset(d, 0, sizeof(d));
+    ref_br_i15_mulacc(d, sk->p, sk->q);
+    ref_br_i15_encode(pq, sizeof(pq), d);
+    ref_br_i15_encode(want, sizeof(want), test_key_pub.m);
+    CHECK(memcmp(pq, want, sizeof(want)) == 0);
+
+    // the Montgomery constants and R^2 of each prime
+    CHECK_EQ(ref_br_i15_ninv15(sk->p[1]), sk->p0i);
+    CHECK_EQ(ref_br_i15_ninv15(sk->q[1]), sk->q0i);
+    slow_r2(d, sk->p);
+    CHECK(i15_equal(d, sk->r2p));
+    slow_r2(d, sk->q);
+    CHECK(i15_equal(d, sk->r2q));
+}
+
+static void test_priv_crt_coefficient(void)
+{
+    const br_rsa_i15_privctx *sk = &test_key_priv;
+    uint16_t qp[BR_RSA_I15_PRIVCTX_WORDS], d[BR_RSA_I15_PRIVCTX_WORDS];
+    unsigned char qb[PRIV_BYTES];
+    size_t qlen = (bit_length(sk->q[0]) + 7) / 8;
+
+    // iq R mod p is reduced, and times q mod p it leaves Montgomery
+    // representation as 1
+    CHECK_EQ(sk->iq[0], sk->p[0]);
+    CHECK(i15_below(sk->iq, sk->p));
+    ref_br_i15_encode(qb, qlen, sk->q);
+    ref_br_i15_decode_reduce(qp, qb, qlen, sk->p);
+    ref_br_i15_montymul(d, sk->iq, qp, sk->p, sk->p0i);
+    CHECK_EQ(d[1], 1);
+    for (size_t u = 2; u <= (size_t)((sk->p[0] + 15) >> 4); u++) {
+        CHECK_EQ(d[u], 0);
+    }
+}
+
+static void test_priv_exponents(void)
+{
+    const br_rsa_i15_privctx *sk = &test_key_priv;
+
+    key_init();
+    check_exponent(sk->p, sk->p0i, sk->dp, sk->dplen);
+    check_exponent(sk->q, sk->q0i, sk->dq, sk->dqlen);
+}
+
+int main(void)
+{
+    i15_test_init(0x45A1C013U);
+    RUN(test_pub_matches_pubctx_init);
+    RUN(test_pub_public_ctx);
+    RUN(test_priv_factors);
+    RUN(test_priv_crt_coefficient);
+    RUN(test_priv_exponents);
+    return test_report("test_rsakey");
+}
@@ -0,0 +1,90 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * br_i15_rsquare() against R^2 mod m the slow way (1 converted to
+ * Montgomery representation twice with the reference
+ * br_i15_to_monty()), on random moduli and on the smallest and largest
+ * ones of each size; and the R^2 that br_rsa_i15_pubctx_init() keeps.
+ */
+
+#define ROUNDS  40
+
+static uint16_t m[I15_WORDS];
+static unsigned char n[I15_TEST_BITS / 8];
+static size_t nlen;
+
+/* Shape of the modulus for round r: random, 10...01 or 11...11 */
+static void make_modulus(unsigned r)
+{
+    unsigned bits = i15_test_bits(r);
+
+    nlen = i15_random_mod(m, n, bits);
+    if (r % 4 == 1) {
+        memset(n + 1, 0, nlen - 1);
+        n[nlen - 1] = 1;
+        n[0] = (unsigned char)(1u << ((bits - 1) % 8));
+    } else if (r % 4 == 2) {
+        memset(n + 1, 0xFF, nlen - 1);
+        n[0] = (unsigned char)(0xFF >> (8 * nlen - bits));
+    }
+    br_i15_decode(m, n, nlen);
+}
+
+static void check_rsquare(void)
+{
+    uint16_t want[I15_WORDS], got[I15_WORDS], t[I15_WORDS];
+    uint16_t m0i = br_i15_ninv15(m[1]);
+
+    br_i15_zero(want, m[0]);
+    want[1] = 1;
+    ref_br_i15_to_monty(want, m);
+    ref_br_i15_to_monty(want, m);
+
+    memset(got, 0xFF, sizeof(got));
+    br_i15_rsquare(got, m, m0i, t);
+    CHECK(i15_equal(got, want));
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_rsquare(void)
+{
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        make_modulus(r);
+        check_rsquare();
+    }
+}
+
+static void test_pubctx_r2(void)
+{
+    static unsigned char e[] = { 0x01, 0x00, 0x01 };
+    br_rsa_i15_pubctx ctx;
+    uint16_t want[I15_WORDS];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        make_modulus(r);
+        if (nlen * 8 > BR_RSA_I15_PUBCTX_MAX_BITS) {
+            continue;
+        }
+        br_rsa_public_key pk = { n, nlen, e, sizeof(e) };
+
+        br_i15_zero(want, m[0]);
+        want[1] = 1;
+        ref_br_i15_to_monty(want, m);
+        ref_br_i15_to_monty(want, m);
+
+        CHECK_EQ(br_rsa_i15_pubctx_init(&ctx, &pk), 1);
+        CHECK(i15_equal(ctx.r2, want));
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x025A0023U);
+    RUN(test_rsquare);
+    RUN(test_pubctx_r2);
+    return test_report("test_rsq");
+}
@@ -0,0 +1,258 @@
+#include <string.h>
+
+#include "test.h"
+#include "bearssl_hash.h"
+
+/*
+ * The SHA-256 of .ovl_sha (sha2small.c): the FIPS 180-2 examples, and
+ * every length across the block and padding boundaries at each
+ * alignment, one-shot and split into updates of every size, against a
+ * textbook implementation (rotating a..h, 64-word schedule).
+ */
+
+#define MSG_LEN  1200
+
+_Alignas(4) static unsigned char msg[MSG_LEN + 4];
+
+/*============================================================================
+ * REFERENCE
+ *============================================================================*/
+
+#define ROTR(x, n)  ((uint32_t)((x) >> (n)) | (uint32_t)((x) << (32 - (n))))
+
+static const uint32_t ref_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void ref_block(uint32_t *h, const unsigned char *p)
+{
+    uint32_t w[64], v[8];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16
+               | (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    memcpy(v, h, sizeof(v));
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = v[7] + (ROTR(v[4], 6) ^ ROTR(v[4], 11) ^ ROTR(v[4], 25))
+                      + ((v[4] & v[5]) ^ (~v[4] & v[6])) + ref_k[i] + w[i];
+        uint32_t t2 = (ROTR(v[0], 2) ^ ROTR(v[0], 13) ^ ROTR(v[0], 22))
+                      + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        memmove(v + 1, v, 7 * sizeof(v[0]));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++) {
+        h[i] += v[i];
+    }
+}
+
+static void ref_sha256(unsigned char *out, const unsigned char *data, size_t len)
+{
+    uint32_t h[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    unsigned char last[128];
+    size_t tail = len % 64, n = tail < 56 ? 64 : 128;
+
+    for (size_t off = 0; off + 64 <= len; off += 64) {
+        ref_block(h, data + off);
+    }
+    memset(last, 0, sizeof(last));
+    memcpy(last, data + len - tail, tail);
+    last[tail] = 0x80;
+    for (int i = 0; i < 8; i++) {
+        last[n - 1 - i] = (unsigned char)((uint64_t)len << 3 >> (8 * i));
+    }
+    ref_block(h, last);
+    if (n == 128) {
+        ref_block(h, last + 64);
+    }
+    for (int i = 0; i < 32; i++) {
+        out[i] = (unsigned char)(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+}
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+static void from_hex(unsigned char *dst, const char *hex)
+{
+    for (size_t i = 0; hex[2 * i]; i++) {
+        unsigned hi = (unsigned)(hex[2 * i] <= '9' ? hex[2 * i] - '0' : hex[2 * i] - 'a' + 10);
+        unsigned lo = (unsigned)(hex[2 * i + 1] <= '9' ? hex[2 * i + 1] - '0' : hex[2 * i + 1] - 'a' + 10);
+        dst[i] = (unsigned char)(hi << 4 | lo);
+    }
+}
+
+static void sha256(unsigned char *out, const void *data, size_t len)
+{
+    br_sha256_context sc;
+
+    br_sha256_init(&sc);
+    br_sha256_update(&sc, data, len);
+    br_sha256_out(&sc, out);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_fips_180_2(void)
+{
+    static const char m2[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    unsigned char want[32], got[32], a[1000];
+    br_sha256_context sc;
+
+    from_hex(want, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    sha256(got, "abc", 3);
+    CHECK(memcmp(got, want, 32) == 0);
+
+    // 448 bits: the length no longer fits the padded block
+    from_hex(want, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    sha256(got, m2, sizeof(m2) - 1);
+    CHECK(memcmp(got, want, 32) == 0);
+
+    // one million 'a', a thousand at a time
+    from_hex(want, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    memset(a, 'a', sizeof(a));
+    br_sha256_init(&sc);
+    for (int i = 0; i < 1000; i++) {
+        br_sha256_update(&sc, a, sizeof(a));
+    }
+    br_sha256_out(&sc, got);
+    CHECK(memcmp(got, want, 32) == 0);
+
+    from_hex(want, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    sha256(got, "", 0);
+    CHECK(memcmp(got, want, 32) == 0);
+
+    // the reference agrees with them
+    ref_sha256(got, (const unsigned char *)m2, sizeof(m2) - 1);
+    from_hex(want, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    CHECK(memcmp(got, want, 32) == 0);
+}
+
+static void test_sha224_shares_rounds(void)
+{
+    unsigned char want[28], got[28];
+    br_sha224_context sc;
+
+    from_hex(want, "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+    br_sha224_init(&sc);
+    br_sha224_update(&sc, "abc", 3);
+    br_sha224_out(&sc, got);
+    CHECK(memcmp(got, want, 28) == 0);
+}
+
+// every length up to MSG_LEN, at every alignment of the input
+static void test_lengths_and_alignment(void)
+{
+    unsigned char want[32], got[32];
+
+    for (size_t len = 0; len <= MSG_LEN; len += len < 200 ? 1 : 61) {
+        for (size_t off = 0; off < 4; off++) {
+            ref_sha256(want, msg + off, len);
+            sha256(got, msg + off, len);
+            CHECK(memcmp(got, want, 32) == 0);
+        }
+    }
+}
+
+// two updates split at every point, and runs of fixed-size updates
+static void test_streaming_splits(void)
+{
+    unsigned char want[32], got[32];
+    br_sha256_context sc;
+
+    ref_sha256(want, msg, 300);
+    for (size_t cut = 0; cut <= 300; cut++) {
+        br_sha256_init(&sc);
+        br_sha256_update(&sc, msg, cut);
+        br_sha256_update(&sc, msg + cut, 300 - cut);
+        br_sha256_out(&sc, got);
+        CHECK(memcmp(got, want, 32) == 0);
+    }
+
+    ref_sha256(want, msg, MSG_LEN);
+    for (size_t chunk = 1; chunk <= 130; chunk++) {
+        br_sha256_init(&sc);
+        for (size_t off = 0; off < MSG_LEN; off += chunk) {
+            br_sha256_update(&sc, msg + off, MSG_LEN - off < chunk ? MSG_LEN - off : chunk);
+        }
+        br_sha256_out(&sc, got);
+        CHECK(memcmp(got, want, 32) == 0);
+    }
+
+    // random chunks, starting at odd addresses
+    ref_sha256(want, msg + 1, MSG_LEN - 1);
+    for (int r = 0; r < 20; r++) {
+        size_t off = 1;
+
+        br_sha256_init(&sc);
+        while (off < MSG_LEN) {
+            size_t n = test_rand() % 150;
+
+            if (n > MSG_LEN - off) {
+                n = MSG_LEN - off;
+            }
+            br_sha256_update(&sc, msg + off, n);
+            off += n;
+        }
+        br_sha256_out(&sc, got);
+        CHECK(memcmp(got, want, 32) == 0);
+    }
+}
+
+// out() leaves the context as it was, and the vtable reaches the same code
+static void test_out_midway_and_vtable(void)
+{
+    unsigned char want[32], got[32];
+    br_sha256_context sc;
+    const br_hash_class *vt = &br_sha256_vtable;
+
+    br_sha256_init(&sc);
+    br_sha256_update(&sc, msg, 100);
+    br_sha256_out(&sc, got);
+    ref_sha256(want, msg, 100);
+    CHECK(memcmp(got, want, 32) == 0);
+    br_sha256_update(&sc, msg + 100, 200);
+    br_sha256_out(&sc, got);
+    ref_sha256(want, msg, 300);
+    CHECK(memcmp(got, want, 32) == 0);
+
+    vt->init(&sc.vtable);
+    vt->update(&sc.vtable, msg, 77);
+    vt->update(&sc.vtable, msg + 77, 223);
+    vt->out(&sc.vtable, got);
+    CHECK(memcmp(got, want, 32) == 0);
+    CHECK_EQ(vt->desc >> BR_HASHDESC_OUT_OFF & BR_HASHDESC_OUT_MASK, 32);
+}
+
+int main(void)
+{
+    test_rng = 0x5A256024U;
+    for (size_t i = 0; i < sizeof(msg); i++) {
+        msg[i] = (unsigned char)test_rand();
+    }
+    RUN(test_fips_180_2);
+    RUN(test_sha224_shares_rounds);
+    RUN(test_lengths_and_alignment);
+    RUN(test_streaming_splits);
+    RUN(test_out_midway_and_vtable);
+    return test_report("test_sha256");
+}
@@ -0,0 +1,141 @@
+#include "test.h"
+#include "i15_util.h"
+
+/*
+ * The BR_I15_SWAR primitives against the plain ones: zero, add and
+ * subtract against br_i15_zero()'s memset and the reference
+ * br_i15_add()/br_i15_sub(), br_ccopy_swar() against the reference
+ * br_ccopy(), and the window lookup against a word loop; at every
+ * relative alignment of the operands, since pairs are only formed
+ * where they agree.
+ */
+
+#define ROUNDS  300
+
+/* Buffer rows of a whole number of 32-bit words */
+#define ROW     ((I15_WORDS + 3) & ~1u)
+
+static union {
+    uint32_t align;
+    uint16_t w[4][ROW];
+    unsigned char b[4][2 * ROW];
+} buf;
+
+static uint16_t tab[32 * ROW];
+
+/* Random bit length, small ones included */
+static unsigned random_bits(void)
+{
+    return 2 + test_rand() % (I15_TEST_BITS - 1);
+}
+
+/*============================================================================
+ * TESTS
+ *============================================================================*/
+
+static void test_zero_swar(void)
+{
+    uint16_t want[I15_WORDS + 2];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        unsigned off = test_rand() % 2;
+        uint16_t bitlen = (uint16_t)(test_rand() % (I15_TEST_BITS + 1));
+        size_t len = (bitlen + 15) >> 4;
+        uint16_t *x = buf.w[0] + off;
+
+        i15_random_bytes(buf.w[0], sizeof(buf.w[0]));
+        memcpy(want, buf.w[0], sizeof(want));
+        want[off] = bitlen;
+        memset(want + off + 1, 0, len * sizeof(uint16_t));
+
+        br_i15_zero_swar(x, bitlen);
+        CHECK(memcmp(buf.w[0], want, sizeof(want)) == 0);
+    }
+}
+
+static void test_add_sub_swar(void)
+{
+    uint16_t m[I15_WORDS];
+    unsigned char n[I15_TEST_BITS / 8];
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        unsigned aoff = test_rand() % 2, boff = test_rand() % 2;
+        uint32_t ctl = test_rand() & 1;
+        uint16_t *a = buf.w[0] + aoff, *b = buf.w[1] + boff;
+        uint16_t *ra = buf.w[2] + aoff, *rb = buf.w[3] + boff;
+
+        // random values, or the largest ones for the longest carries
+        i15_random_mod(m, n, random_bits());
+        i15_random_below(a, m);
+        i15_random_below(b, m);
+        if (r % 8 == 0) {
+            memcpy(b, m, sizeof(m));
+        }
+
+        memcpy(ra, a, sizeof(m));
+        CHECK_EQ(br_i15_add_swar(a, b, ctl), ref_br_i15_add(ra, b, ctl));
+        CHECK(i15_equal(a, ra));
+
+        CHECK_EQ(br_i15_sub_swar(a, b, ctl), ref_br_i15_sub(ra, b, ctl));
+        CHECK(i15_equal(a, ra));
+
+        // the other way round, with a borrow out half of the time
+        memcpy(rb, b, sizeof(m));
+        CHECK_EQ(br_i15_sub_swar(b, a, ctl), ref_br_i15_sub(rb, ra, ctl));
+        CHECK(i15_equal(b, rb));
+    }
+}
+
+static void test_ccopy_swar(void)
+{
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        size_t doff = test_rand() % 8, soff = test_rand() % 8;
+        size_t len = test_rand() % (sizeof(buf.b[0]) - 7);
+        uint32_t ctl = test_rand() & 1;
+
+        i15_random_bytes(buf.b[0], sizeof(buf.b[0]));
+        i15_random_bytes(buf.b[1], sizeof(buf.b[1]));
+        memcpy(buf.b[2], buf.b[0], sizeof(buf.b[0]));
+
+        br_ccopy_swar(ctl, buf.b[0] + doff, buf.b[1] + soff, len);
+        ref_br_ccopy(ctl, buf.b[2] + doff, buf.b[1] + soff, len);
+        CHECK(memcmp(buf.b[0], buf.b[2], sizeof(buf.b[0])) == 0);
+    }
+}
+
+static void test_lookup_swar(void)
+{
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        size_t mwlen = 1 + test_rand() % (I15_WORDS + 1);
+        uint32_t num = 2 + test_rand() % 31;
+        uint32_t idx = test_rand() % (num + 1);
+        unsigned doff = test_rand() % 2, toff = test_rand() % 2;
+        uint16_t *d = buf.w[0] + doff, *want = buf.w[1] + doff;
+        const uint16_t *t = tab + toff;
+
+        if (r % 2 == 0) {
+            mwlen += mwlen & 1;         // as br_i15_modpow_opt() sizes it
+        }
+        i15_random_bytes(tab, sizeof(tab));
+        i15_random_bytes(buf.w[0], sizeof(buf.w[0]));
+        memcpy(buf.w[1], buf.w[0], sizeof(buf.w[0]));
+
+        // words 1 to mwlen-1 of entry idx, or zero
+        for (size_t v = 1; v < mwlen; v++) {
+            want[v] = (idx >= 1 && idx < num) ? t[(idx - 1) * mwlen + v] : 0;
+        }
+
+        br_i15_lookup_swar(d, t, mwlen, num, idx);
+        CHECK(memcmp(buf.w[0], buf.w[1], sizeof(buf.w[0])) == 0);
+    }
+}
+
+int main(void)
+{
+    i15_test_init(0x5A4A0022U);
+    RUN(test_zero_swar);
+    RUN(test_add_sub_swar);
+    RUN(test_ccopy_swar);
+    RUN(test_lookup_swar);
+    return test_report("test_swar");
+}
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""Overlay build-time generator.
+
+ids     Number the overlays: every .ovl_<name> output section of the
+        linker script gets OVL_<NAME>, in the order the script lists
+        them, written to a header that overlay.h includes. The same
+        numbering indexes the descriptor table tools/ovlpack.py builds,
+        so adding an overlay only takes a new output section.
+
+stubs   Scan the compiled objects for functions placed in .ovl_<name>
+        sections that are called from outside their overlay, and emit
+        flash-resident entry stubs for them plus the matching
+        -Wl,--wrap options. A call to foo() from outside the overlay then
+        lands in __wrap_foo, which makes the overlay resident through
+        ovl_enter(OVL_<NAME>) and tail-calls the SRAM copy (__real_foo).
+        Besides section attributes, code can be assigned to an overlay
+        by a linker fragment (--assign rsa=ovl_rsa.ld, as written by
+        tools/ovlpart.py): every .text section of the objects it names
+        then belongs to that overlay.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+OVL_SECTION = re.compile(r'^\.ovl_([A-Za-z0-9]+)(\..*)?$')
+SYMTAB_LINE = re.compile(r'^([0-9a-fA-F]+) (.{7}) (\S+)\t([0-9a-fA-F]+) +(\S+)$')
+RELOC_HEAD = re.compile(r'^RELOCATION RECORDS FOR \[(.+)\]:$')
+RELOC_LINE = re.compile(r'^[0-9a-fA-F]+ +(R_\S+) +(\S+)$')
+# Non-code sections whose relocations are not calls
+NOT_CODE = re.compile(r'^\.(debug|eh_frame|ARM\.exidx|ARM\.extab|comment|note)')
+# Object pattern in a linker fragment: */i15_montmul.o(.text .text.*)
+FRAGMENT_LINE = re.compile(r'^\s*\*/([^\s(]+)\(')
+# Output section statement in a linker script: .ovl_rsa [: ...] [{]
+LDSCRIPT_OVERLAY = re.compile(r'^\s*\.ovl_([A-Za-z0-9]+)\s*(?::|\{|$)')
+LD_COMMENT = re.compile(r'/\*.*?\*/', re.S)
+
+
+def overlay_of(section, obj=None, placed=None):
+    """Overlay name for a section, or None if it is not an overlay section."""
+    m = OVL_SECTION.match(section)
+    if m:
+        return m.group(1)
+    if placed and section.startswith('.text'):
+        return placed.get(os.path.basename(obj))
+    return None
+
+
+def read_assignments(specs):
+    """Map object basenames to overlays from NAME=FRAGMENT options."""
+    placed = {}
+    for spec in specs:
+        ovl, _, path = spec.partition('=')
+        with open(path) as f:
+            for line in f:
+                m = FRAGMENT_LINE.match(line)
+                if m:
+                    placed[m.group(1)] = ovl
+    return placed
+
+
+def objdump(tool, flag, obj):
+    return subprocess.run([tool, flag, obj], check=True,
+                          stdout=subprocess.PIPE,
+                          universal_newlines=True).stdout.splitlines()
+
+
+def scan(tool, objects, placed):
+    """Return ({symbol: (overlay, is_function)}, [(object, section, overlay, symbol)])."""
+    defs = {}
+    refs = []
+    for obj in objects:
+        for line in objdump(tool, '-t', obj):
+            m = SYMTAB_LINE.match(line)
+            if not m:
+                continue
+            flags, section, name = m.group(2), m.group(3), m.group(5)
+            ovl = overlay_of(section, obj, placed)
+            if ovl is None or flags[0] != 'g':
+                continue
+            defs[name] = (ovl, flags[6] == 'F')
+
+        section = None
+        for line in objdump(tool, '-r', obj):
+            m = RELOC_HEAD.match(line)
+            if m:
+                section = None if NOT_CODE.match(m.group(1)) else m.group(1)
+                continue
+            m = RELOC_LINE.match(line)
+            if m and section is not None:
+                refs.append((obj, section, overlay_of(section, obj, placed),
+                             re.split(r'[+-]0x', m.group(2))[0]))
+    return defs, refs
+
+
+def exported(defs, refs):
+    """Overlay symbols referenced from code outside their own overlay."""
+    entries = {}
+    for obj, section, where, sym in refs:
+        if sym not in defs:
+            continue
+        ovl, is_func = defs[sym]
+        if where == ovl:
+            continue
+        if not is_func:
+            sys.stderr.write('ovlgen: warning: %s in .ovl_%s is data referenced '
+                             'from %s(%s); no stub generated\n'
+                             % (sym, ovl, obj, section))
+            continue
+        entries[sym] = ovl
+    return entries
+
+
+STUB = '''
+	.section .text.__wrap_{sym},"ax",%progbits
+	.global	__wrap_{sym}
+	.type	__wrap_{sym}, %function
+__wrap_{sym}:
+	push	{{r0, r1, r2, r3, r4, lr}}
+	movs	r0, #OVL_{ovl}
+	bl	ovl_enter
+	ldr	r0, [sp, #20]
+	mov	lr, r0
+	ldr	r0, =__real_{sym}
+	str	r0, [sp, #20]
+	pop	{{r0, r1, r2, r3, r4}}
+	pop	{{pc}}
+	.ltorg
+	.size	__wrap_{sym}, .-__wrap_{sym}
+'''
+
+HEADER = '''/* Generated by tools/ovlgen.py -- do not edit. */
+
+/*
+ * Overlay entry stubs. Each one saves the argument registers, makes the
+ * overlay resident, then restores the caller's registers and stack and
+ * jumps to the SRAM copy with the caller's return address in lr, so
+ * stack-passed arguments and the return value pass straight through.
+ */
+
+#include "overlay.h"
+
+	.syntax unified
+	.cpu cortex-m0plus
+	.thumb
+'''
+
+
+IDS = '''/* Generated by tools/ovlgen.py from {script} -- do not edit. */
+
+#ifndef OVL_IDS_H
+#define OVL_IDS_H
+
+{defines}
+#define OVL_COUNT        {count}
+
+#endif /* OVL_IDS_H */
+'''
+
+
+def ldscript_overlays(path):
+    """Overlay names in the order their output sections appear."""
+    with open(path) as f:
+        text = LD_COMMENT.sub('', f.read())
+    names = []
+    for line in text.splitlines():
+        m = LDSCRIPT_OVERLAY.match(line)
+        if m and m.group(1) not in names:
+            names.append(m.group(1))
+    return names
+
+
+def cmd_ids(args):
+    names = ldscript_overlays(args.ldscript)
+    if not names:
+        sys.exit('ovlgen: no .ovl_* output sections in %s' % args.ldscript)
+    if len(names) > 0xFF:
+        sys.exit('ovlgen: %d overlays; ids are 8 bits' % len(names))
+    defines = '\n'.join('#define %-16s %-4d /* .ovl_%s */'
+                        % ('OVL_' + n.upper(), i, n) for i, n in enumerate(names))
+    text = IDS.format(script=args.ldscript, defines=defines, count=len(names))
+
+    # leave an unchanged header alone so nothing recompiles
+    try:
+        with open(args.output) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(args.output, 'w') as f:
+        f.write(text)
+
+
+def cmd_stubs(args):
+    defs, refs = scan(args.objdump, args.objects, read_assignments(args.assign))
+    entries = exported(defs, refs)
+
+    with open(args.asm, 'w') as f:
+        f.write(HEADER)
+        for sym in sorted(entries):
+            f.write(STUB.format(sym=sym, ovl=entries[sym].upper()))
+
+    with open(args.wrap, 'w') as f:
+        for sym in sorted(entries):
+            f.write('-Wl,--wrap=%s\n' % sym)
+
+    for sym in sorted(entries):
+        print('ovlgen: stub %-28s -> .ovl_%s' % (sym, entries[sym]))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = ap.add_subparsers(dest='cmd')
+    sub.required = True
+
+    p = sub.add_parser('ids', help='number the overlays of a linker script')
+    p.add_argument('--ldscript', required=True)
+    p.add_argument('-o', '--output', required=True, help='output header')
+    p.set_defaults(func=cmd_ids)
+
+    p = sub.add_parser('stubs', help='generate overlay entry stubs')
+    p.add_argument('--objdump', default='arm-none-eabi-objdump')
+    p.add_argument('--asm', required=True, help='output assembly file')
+    p.add_argument('--wrap', required=True, help='output linker option file')
+    p.add_argument('--assign', action='append', default=[], metavar='NAME=FRAGMENT',
+                   help='objects listed in FRAGMENT belong to .ovl_NAME')
+    p.add_argument('objects', nargs='+')
+    p.set_defaults(func=cmd_stubs)
+
+    args = ap.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
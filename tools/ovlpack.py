@@ -0,0 +1,368 @@
+#!/usr/bin/env python3
+"""Overlay image packer.
+
+Builds the flash image (.bin and Intel .hex) from the linked ELF. The
+overlay output sections (.ovl_<name>) are linked at load addresses in a
+region that is never programmed; their images are collected, together
+with a descriptor table, at __ovl_table right behind the rest of the
+firmware:
+
+    magic 'OVLT', count, entries
+    count x { id, method, lma, vma, size, packed_size, crc,
+              entry_first:16, entry_count:16 }
+    entries x run address of a global function (Thumb bit set)
+    images, each word aligned
+
+Descriptors are in id order, as numbered by `ovlgen.py ids` (--ids), so
+the manager indexes them directly. Each image is LZ4-compressed (block
+format) when that makes it smaller, otherwise stored raw so the loader
+can DMA it. Overlays named with --raw are always stored raw: they are
+the ones the firmware prefetches, and a packed image is decoded by the
+CPU before the prefetch returns. crc is the STM32 CRC unit checksum of the unpacked image
+(see stm32_crc), which the loader compares against while copying. The
+layout matches ovl_table_t in Core/Inc/overlay.h.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FLASH_BASE = 0x08000000
+FLASH_SIZE = 64 * 1024
+OVL_SECTION = re.compile(r'^\.ovl_[A-Za-z0-9]+$')
+# Line of the generated ids header: #define OVL_RSA 0 /* .ovl_rsa */
+OVL_ID = re.compile(r'^#define\s+OVL_\w+\s+(\d+)\s+/\*\s*(\.ovl_[A-Za-z0-9]+)\s*\*/')
+
+TABLE_MAGIC = 0x544C564F
+DESC_SIZE = 32
+PACK_RAW = 0
+PACK_LZ4 = 1
+
+SHT_NOBITS = 8
+SHT_SYMTAB = 2
+SHF_ALLOC = 2
+PT_LOAD = 1
+STB_GLOBAL = 1
+STT_FUNC = 2
+
+
+#############################################################################
+# ELF32 (little endian) reader
+#############################################################################
+
+class Elf:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b'\x7fELF' or d[4] != 1 or d[5] != 1:
+            sys.exit('ovlpack: %s: not a little-endian ELF32 file' % path)
+        (self.entry, phoff, shoff, _, _, phentsize, phnum, shentsize,
+         shnum, shstrndx) = struct.unpack_from('<IIIIHHHHHH', d, 24)
+
+        self.segments = [struct.unpack_from('<IIIIIIII', d, phoff + i * phentsize)
+                         for i in range(phnum)]
+        raw = [struct.unpack_from('<IIIIIIIIII', d, shoff + i * shentsize)
+               for i in range(shnum)]
+        names = raw[shstrndx][4]
+        self.sections = [dict(name=self.cstr(names + s[0]), type=s[1], flags=s[2],
+                              addr=s[3], offset=s[4], size=s[5], link=s[6])
+                         for s in raw]
+
+    def cstr(self, off):
+        return self.data[off:self.data.index(b'\0', off)].decode()
+
+    def contents(self, sec):
+        return self.data[sec['offset']:sec['offset'] + sec['size']]
+
+    def lma(self, sec):
+        """Load address of an allocated section, from the segment holding it."""
+        for (ptype, off, vaddr, paddr, filesz, _, _, _) in self.segments:
+            if ptype == PT_LOAD and off <= sec['offset'] < off + filesz:
+                return paddr + sec['offset'] - off
+        return sec['addr']
+
+    def symbols(self):
+        """(name, value, info, section index) of every symbol."""
+        for sec in self.sections:
+            if sec['type'] != SHT_SYMTAB:
+                continue
+            strtab = self.sections[sec['link']]['offset']
+            for off in range(sec['offset'], sec['offset'] + sec['size'], 16):
+                st_name, value, _, info, _, shndx = struct.unpack_from(
+                    '<IIIBBH', self.data, off)
+                yield self.cstr(strtab + st_name), value, info, shndx
+
+    def symbol(self, name):
+        for sym, value, _, _ in self.symbols():
+            if sym == name:
+                return value
+        sys.exit('ovlpack: symbol %s not found' % name)
+
+    def functions(self, index):
+        """Addresses of the global functions defined in section index."""
+        return sorted({value for _, value, info, shndx in self.symbols()
+                       if shndx == index and info >> 4 == STB_GLOBAL
+                       and info & 15 == STT_FUNC})
+
+
+#############################################################################
+# STM32 CRC unit model
+#############################################################################
+
+CRC_POLY = 0x04C11DB7
+
+
+def stm32_crc(data, crc=0xFFFFFFFF):
+    """CRC unit in its reset configuration: CRC-32 polynomial, all-ones
+    seed, no input/output reflection, no final XOR, fed 32-bit words read
+    little-endian from memory (CRC->DR = *(uint32_t *)p)."""
+    if len(data) % 4:
+        raise ValueError('CRC input must be whole words')
+    for (word,) in struct.iter_unpack('<I', data):
+        crc ^= word
+        for _ in range(32):
+            crc = (crc << 1 ^ CRC_POLY if crc & 0x80000000 else crc << 1) & 0xFFFFFFFF
+    return crc
+
+
+#############################################################################
+# LZ4 block format
+#############################################################################
+
+def lz4_length(out, n):
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+
+
+def lz4_compress(data):
+    """LZ4 block compressor. Images are a few KB, so every earlier
+    position with the same 4-byte prefix is tried and the longest match
+    wins, with one step of lazy matching. The last 5 bytes are always
+    literals and no match starts within the last 12 (LZ4 end rules)."""
+    n = len(data)
+    out = bytearray()
+    chains = {}
+    anchor = 0
+
+    def longest(i):
+        best = (0, 0)
+        if i >= n - 12:
+            return best
+        for cand in reversed(chains.get(data[i:i + 4], ())):
+            if i - cand > 0xFFFF:
+                break
+            m = 4
+            while i + m < n - 5 and data[cand + m] == data[i + m]:
+                m += 1
+            if m > best[0]:
+                best = (m, i - cand)
+        return best
+
+    def insert(i):
+        if i < n - 3:
+            chains.setdefault(data[i:i + 4], []).append(i)
+
+    def sequence(end, offset=None, mlen=0):
+        lit = end - anchor
+        token = min(lit, 15) << 4
+        if offset is not None:
+            token |= min(mlen - 4, 15)
+        out.append(token)
+        if lit >= 15:
+            lz4_length(out, lit - 15)
+        out.extend(data[anchor:end])
+        if offset is not None:
+            out.extend(struct.pack('<H', offset))
+            if mlen - 4 >= 15:
+                lz4_length(out, mlen - 4 - 15)
+
+    i = 0
+    while i < n - 12:
+        m, off = longest(i)
+        if m and longest(i + 1)[0] > m + 1:
+            m = 0
+        if not m:
+            insert(i)
+            i += 1
+            continue
+        sequence(i, off, m)
+        for j in range(i, i + m):
+            insert(j)
+        i += m
+        anchor = i
+    sequence(n)
+    return bytes(out)
+
+
+def lz4_decompress(src, size):
+    out = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]
+        i += 1
+
+        def length(n):
+            nonlocal i
+            if n == 15:
+                while True:
+                    b = src[i]
+                    i += 1
+                    n += b
+                    if b != 255:
+                        break
+            return n
+        lit = length(token >> 4)
+        out += src[i:i + lit]
+        i += lit
+        if i >= len(src):
+            break
+        off = src[i] | src[i + 1] << 8
+        i += 2
+        for _ in range(length(token & 15) + 4):
+            out.append(out[-off])
+    if len(out) != size:
+        raise ValueError('size mismatch')
+    return bytes(out)
+
+
+#############################################################################
+# Output
+#############################################################################
+
+def pad4(b):
+    return b + b'\xff' * (-len(b) % 4)
+
+
+def read_ids(path):
+    """Overlay section names in id order, from the ovlgen.py ids header."""
+    ids = {}
+    with open(path) as f:
+        for line in f:
+            m = OVL_ID.match(line)
+            if m:
+                ids[int(m.group(1))] = m.group(2)
+    if sorted(ids) != list(range(len(ids))):
+        sys.exit('ovlpack: %s: overlay ids are not 0..n-1' % path)
+    return [ids[i] for i in range(len(ids))]
+
+
+def build_table(base, images, method, raw_names=()):
+    """images: [(name, vma, bytes, entry points)] in id order; the
+    sections in raw_names are stored raw whatever the method
+    -> (table bytes for address base, report lines)."""
+    entries = [e for _, _, _, points in images for e in points]
+    header = 12 + DESC_SIZE * len(images) + 4 * len(entries)
+    descs = []
+    blobs = bytearray()
+    report = []
+    first = 0
+    for ident, (name, vma, raw, points) in enumerate(images):
+        packed, how = raw, PACK_RAW
+        if method == 'lz4' and name not in raw_names:
+            z = lz4_compress(raw)
+            if lz4_decompress(z, len(raw)) != raw:
+                sys.exit('ovlpack: LZ4 round trip failed for %s' % name)
+            if len(z) < len(raw):
+                packed, how = z, PACK_LZ4
+        descs.append(struct.pack('<IIIIIIIHH', ident, how,
+                                 base + header + len(blobs), vma, len(raw),
+                                 len(packed), stm32_crc(raw), first, len(points)))
+        first += len(points)
+        blobs += pad4(packed)
+        report.append('ovlpack: %d %-10s %5d -> %5d bytes (%s), %d entries'
+                      % (ident, name, len(raw), len(packed),
+                         'lz4' if how == PACK_LZ4 else 'raw', len(points)))
+    if first > 0xFFFF:
+        sys.exit('ovlpack: %d entry points do not fit the table' % first)
+    table = (struct.pack('<III', TABLE_MAGIC, len(images), len(entries))
+             + b''.join(descs) + struct.pack('<%dI' % len(entries), *entries)
+             + blobs)
+    return table, report
+
+
+def write_hex(path, base, image, entry):
+    def record(kind, addr, data):
+        rec = bytes([len(data), addr >> 8 & 0xFF, addr & 0xFF, kind]) + data
+        return ':%s%02X\n' % (rec.hex().upper(), -sum(rec) & 0xFF)
+
+    with open(path, 'w') as f:
+        upper = None
+        for off in range(0, len(image), 16):
+            addr = base + off
+            if addr >> 16 != upper:
+                upper = addr >> 16
+                f.write(record(4, 0, struct.pack('>H', upper)))
+            f.write(record(0, addr & 0xFFFF, image[off:off + 16]))
+        f.write(record(5, 0, struct.pack('>I', entry)))
+        f.write(record(1, 0, b''))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--method', choices=('lz4', 'raw'), default='lz4')
+    ap.add_argument('--raw', action='append', default=[], metavar='SECTION',
+                    help='store this overlay raw so it can be prefetched by DMA')
+    ap.add_argument('--ids', required=True, help='header from ovlgen.py ids')
+    ap.add_argument('--bin', required=True)
+    ap.add_argument('--hex', required=True)
+    ap.add_argument('elf')
+    args = ap.parse_args()
+
+    elf = Elf(args.elf)
+    flash = bytearray()
+    overlays = {}
+    for index, sec in enumerate(elf.sections):
+        if not sec['flags'] & SHF_ALLOC or sec['type'] == SHT_NOBITS:
+            continue
+        if OVL_SECTION.match(sec['name']):
+            overlays[sec['name']] = (sec['addr'], elf.contents(sec),
+                                     elf.functions(index))
+            continue
+        if not sec['size']:
+            continue
+        lma = elf.lma(sec)
+        if not FLASH_BASE <= lma <= lma + sec['size'] <= FLASH_BASE + FLASH_SIZE:
+            sys.exit('ovlpack: %s at 0x%08x is outside flash' % (sec['name'], lma))
+        off = lma - FLASH_BASE
+        if len(flash) < off + sec['size']:
+            flash += b'\xff' * (off + sec['size'] - len(flash))
+        flash[off:off + sec['size']] = elf.contents(sec)
+
+    images = []
+    for name in read_ids(args.ids):
+        if name not in overlays:
+            sys.exit('ovlpack: %s has an id but is not in %s' % (name, args.elf))
+        images.append((name,) + overlays.pop(name))
+    if overlays:
+        sys.exit('ovlpack: no id for %s; regenerate %s'
+                 % (', '.join(sorted(overlays)), args.ids))
+
+    unknown = set(args.raw) - {name for name, _, _, _ in images}
+    if unknown:
+        sys.exit('ovlpack: --raw %s: no such overlay' % ', '.join(sorted(unknown)))
+
+    table_at = elf.symbol('__ovl_table') - FLASH_BASE
+    if table_at < len(flash):
+        sys.exit('ovlpack: __ovl_table overlaps the firmware')
+    table, report = build_table(FLASH_BASE + table_at, images, args.method,
+                                args.raw)
+    flash += b'\xff' * (table_at - len(flash)) + table
+    if len(flash) > FLASH_SIZE:
+        sys.exit('ovlpack: image is %d bytes, flash holds %d' % (len(flash), FLASH_SIZE))
+
+    with open(args.bin, 'wb') as f:
+        f.write(flash)
+    write_hex(args.hex, FLASH_BASE, bytes(flash), elf.entry)
+
+    for line in report:
+        print(line)
+    print('ovlpack: table %d bytes @ 0x%08x, flash %d/%d bytes'
+          % (len(table), FLASH_BASE + table_at, len(flash), FLASH_SIZE))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+"""Profile-guided overlay partitioning.
+
+Reads the linker map of a previous build (-Map with --cref) and an
+execution-count profile, picks the object files whose code should run
+from an overlay bank, and writes a linker script fragment that the
+bank's output section INCLUDEs:
+
+    */i15_montmul.o(.text .text.*)
+
+The unit of selection is an object file, not a function: statics and
+calls between functions of the same object can then never straddle the
+flash/SRAM boundary without going through an entry stub. Code pinned
+with __attribute__((section(".ovl_<name>"))) stays where it is; it is
+counted against the budget, and objects carrying a section attribute
+for a different overlay are left alone, as is code that another
+overlay's fragment already places (e.g. ovl_sha.ld) and code in the
+always-resident .ramfunc section.
+
+Profile format, one function per line ('#' starts a comment):
+
+    <function> <count> [<calls>]
+
+count is how often the function's code ran, e.g. the summed line
+execution counts that `gcov --json-format` reports for a host build of
+the same sources. calls is its entry count; calls that arrive from
+outside the overlay pay for a trip through the entry stub.
+
+Estimated gain of a selection (cycles per profiled run):
+
+    saving * sum(count)                       code fetched from SRAM
+  - stub_cost * sum(calls entering via stub)  ovl_enter() on the way in
+  - loads * copy_cost * bytes                 copying the image in
+
+subject to bytes + pinned code + long-branch veneers <= budget. A 0/1
+knapsack over the objects gives the starting point; a local search
+then accounts for the stub and veneer terms, which depend on what else
+is selected.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+OUTPUT_SECTION = re.compile(r'^(\.\S+)')
+INPUT_SECTION = re.compile(r'^ (\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+))?$')
+INPUT_CONTINUED = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$')
+SYMBOL_LINE = re.compile(r'^\s{16,}0x[0-9a-fA-F]+\s+([A-Za-z_.$][\w.$]*)$')
+CREF_FIRST = re.compile(r'^(\S+)\s+(\S+)$')
+CREF_MORE = re.compile(r'^\s+(\S+)$')
+CODE_SECTION = re.compile(r'^\.(text|ovl_)')
+OVL_SECTION = re.compile(r'^\.ovl_([A-Za-z0-9]+)(\..*)?$')
+
+# Always-resident SRAM code (ramfunc.ld); never a candidate, and calls
+# into it from a bank need no veneer
+RESIDENT_SECTION = '.ramfunc'
+
+# Thumb-only (v6-M) long branch stub ld emits for SRAM -> flash calls
+VENEER_SIZE = 16
+ALIGN = 4
+
+
+class Unit:
+    """Code of one object file."""
+
+    def __init__(self, path):
+        self.path = path
+        self.size = 0
+        self.functions = set()      # global symbols and .text.<name> names
+        self.pinned = set()         # overlays named by section attributes
+        self.pinned_size = 0
+        self.placed = set()         # overlays whose output section holds it
+        self.count = 0
+        self.value = 0.0
+
+
+def align(n):
+    return (n + ALIGN - 1) & ~(ALIGN - 1)
+
+
+def parse_map(path):
+    """Return ({object: Unit}, {function: [referencing files]}, {function: file}).
+
+    Files are object paths or archive(member) as ld prints them.
+    """
+    units = {}
+    refs = {}
+    defined = {}
+    code = set()
+    state = None
+    pending = None
+    current = None
+    output = None
+    cref_sym = None
+
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if line.startswith('Linker script and memory map'):
+                state = 'map'
+                continue
+            if line.startswith('Cross Reference Table'):
+                state = 'cref'
+                continue
+            if state == 'map':
+                m = OUTPUT_SECTION.match(line)
+                if m:
+                    output, pending, current = m.group(1), None, None
+                    continue
+                m = INPUT_SECTION.match(line)
+                if m:
+                    current = None
+                    pending = m.group(1)
+                    if m.group(2) is None:
+                        continue
+                    size, obj = int(m.group(3), 16), m.group(4)
+                elif pending is not None and INPUT_CONTINUED.match(line):
+                    m = INPUT_CONTINUED.match(line)
+                    size, obj = int(m.group(2), 16), m.group(3)
+                else:
+                    pending = None
+                    m = SYMBOL_LINE.match(line)
+                    if m and current is not None:
+                        code.add(m.group(1))
+                        if current is not True:
+                            current.functions.add(m.group(1))
+                    continue
+
+                section, pending = pending, None
+                if (output == RESIDENT_SECTION or not CODE_SECTION.match(section)
+                        or size == 0):
+                    continue
+                if not obj.endswith('.o') or '(' in obj:
+                    current = True      # library code: never moved
+                    continue
+                current = units.setdefault(obj, Unit(obj))
+                current.size += align(size)
+                placed = OVL_SECTION.match(output or '')
+                if placed:
+                    current.placed.add(placed.group(1))
+                ovl = OVL_SECTION.match(section)
+                if ovl:
+                    current.pinned.add(ovl.group(1))
+                    current.pinned_size += align(size)
+                elif section.startswith('.text.'):
+                    current.functions.add(section[len('.text.'):])
+            elif state == 'cref':
+                m = CREF_MORE.match(line)
+                if m and cref_sym is not None:
+                    refs.setdefault(cref_sym, []).append(m.group(1))
+                    continue
+                m = CREF_FIRST.match(line)
+                cref_sym = None
+                if m and m.group(1) in code:
+                    cref_sym = m.group(1)
+                    defined[cref_sym] = m.group(2)
+    return units, refs, defined
+
+
+def parse_profile(path):
+    """Return ({function: count}, {function: calls})."""
+    counts = {}
+    calls = {}
+    with open(path) as f:
+        for n, line in enumerate(f, 1):
+            fields = line.split('#', 1)[0].split()
+            if not fields:
+                continue
+            if len(fields) not in (2, 3):
+                sys.exit('ovlpart: %s:%d: expected <function> <count> [<calls>]'
+                         % (path, n))
+            counts[fields[0]] = int(fields[1])
+            if len(fields) == 3:
+                calls[fields[0]] = int(fields[2])
+    return counts, calls
+
+
+class Model:
+    def __init__(self, args, units, refs, defined, calls, inside):
+        self.args = args
+        self.units = units
+        self.refs = refs
+        self.defined = defined
+        self.calls = calls
+        self.inside = inside        # objects already in the bank (pinned)
+
+    def cost(self, sel):
+        """(bytes, veneers, stub penalty) for the selected set of objects."""
+        members = self.inside | sel
+        size = sum(self.units[p].size for p in sel)
+        veneers = set()
+        stubbed = 0
+        for sym, users in self.refs.items():
+            owner = self.defined.get(sym)
+            if owner is None:
+                continue
+            mine = owner in members
+            outside = any(u not in members for u in users)
+            if mine and outside:
+                stubbed += self.calls.get(sym, 0)
+            # calls out of the bank, or back in through a flash stub
+            if (not mine or outside) and any(u in members and u != owner
+                                             for u in users):
+                veneers.add(sym)
+        return size, len(veneers), stubbed
+
+    def evaluate(self, sel, budget):
+        size, veneers, stubbed = self.cost(sel)
+        if size + veneers * VENEER_SIZE > budget:
+            return None
+        return (sum(self.units[p].value for p in sel)
+                - self.args.stub_cost * stubbed)
+
+
+def knapsack(items, budget):
+    """0/1 knapsack on (path, size, value); sizes in ALIGN-byte units."""
+    cap = budget // ALIGN
+    best = [0.0] * (cap + 1)
+    take = [[False] * (cap + 1) for _ in items]
+    for i, (_, size, value) in enumerate(items):
+        w = size // ALIGN
+        for c in range(cap, w - 1, -1):
+            if best[c - w] + value > best[c]:
+                best[c] = best[c - w] + value
+                take[i][c] = True
+    sel = set()
+    c = cap
+    for i in range(len(items) - 1, -1, -1):
+        if take[i][c]:
+            sel.add(items[i][0])
+            c -= items[i][1] // ALIGN
+    return sel
+
+
+def improve(model, cands, sel, budget):
+    """Toggle or swap single objects while the full estimate improves."""
+    score = model.evaluate(sel, budget)
+    if score is None:
+        score = float('-inf')
+    changed = True
+    while changed:
+        changed = False
+        moves = [sel ^ {p} for p in cands]
+        moves += [(sel - {a}) | {b} for a in sel for b in cands if b not in sel]
+        for trial in moves:
+            s = model.evaluate(trial, budget)
+            if s is not None and s > score + 1e-9:
+                sel, score, changed = trial, s, True
+                break
+    return sel, score
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--map', required=True, help='linker map with --cref')
+    ap.add_argument('--profile', required=True)
+    ap.add_argument('--overlay', required=True, help='bank to fill, e.g. rsa')
+    ap.add_argument('--budget', type=int, required=True, help='bank size in bytes')
+    ap.add_argument('--reserve', type=int, default=32,
+                    help='bytes kept free for alignment and late growth')
+    ap.add_argument('--saving', type=float, default=2.0,
+                    help='cycles saved per profile count when run from SRAM')
+    ap.add_argument('--stub-cost', type=float, default=60.0,
+                    help='cycles per call entering through a stub')
+    ap.add_argument('--copy-cost', type=float, default=1.5,
+                    help='cycles per byte to load the image')
+    ap.add_argument('--loads', type=float, default=1.0,
+                    help='overlay loads per profiled run')
+    ap.add_argument('-o', '--output', required=True, help='linker fragment')
+    args = ap.parse_args()
+
+    units, refs, defined = parse_map(args.map)
+    counts, calls = parse_profile(args.profile)
+
+    seen = set()
+    for unit in units.values():
+        for fn in unit.functions & counts.keys():
+            unit.count += counts[fn]
+            seen.add(fn)
+        unit.value = (args.saving * unit.count
+                      - args.loads * args.copy_cost * unit.size)
+    for fn in sorted(counts.keys() - seen):
+        sys.stderr.write('ovlpart: warning: %s is not in %s\n' % (fn, args.map))
+
+    inside = {p for p, u in units.items() if args.overlay in u.pinned}
+    pinned = sum(units[p].pinned_size for p in inside)
+    budget = args.budget - args.reserve - pinned
+    if budget < 0:
+        sys.exit('ovlpart: pinned .ovl_%s code (%d bytes) exceeds the budget'
+                 % (args.overlay, pinned))
+    cands = sorted(p for p, u in units.items()
+                   if not u.pinned and not u.placed - {args.overlay}
+                   and u.value > 0 and u.size <= budget)
+
+    model = Model(args, units, refs, defined, calls, inside)
+    sel = knapsack([(p, units[p].size, units[p].value) for p in cands], budget)
+    sel, score = improve(model, cands, sel, budget)
+    size, veneers, stubbed = model.cost(sel)
+
+    with open(args.output, 'w') as out:
+        out.write('/* Generated by tools/ovlpart.py from %s and %s.\n'
+                  % (args.map, args.profile))
+        out.write('   Do not edit; rerun `make partition` instead.\n\n')
+        out.write('   budget %d bytes: %d selected, %d pinned, %d veneers,'
+                  ' %d reserved\n' % (args.budget, size, pinned,
+                                      veneers * VENEER_SIZE, args.reserve))
+        out.write('   estimated gain %.0f cycles per profiled run,'
+                  ' %d calls through stubs */\n\n' % (score, stubbed))
+        for p in sorted(sel, key=lambda p: -units[p].value):
+            out.write('*/%s(.text .text.*)%s/* %5d bytes, count %d */\n'
+                      % (os.path.basename(p),
+                         ' ' * max(1, 28 - len(os.path.basename(p))),
+                         units[p].size, units[p].count))
+
+    sys.stderr.write('ovlpart: .ovl_%s: %d objects, %d/%d bytes, ~%.0f cycles\n'
+                     % (args.overlay, len(sel), size + pinned
+                        + veneers * VENEER_SIZE, args.budget, score))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,400 @@
+#!/usr/bin/env python3
+"""RSA key compiler.
+
+Turns PEM or DER RSA keys into C tables for the BearSSL "i15" engine,
+so that the device does no key setup and no DER parsing:
+
+    rsakey.py -o build/rsa_keys.c --header build/rsa_keys.h \\
+        test_key=data/rsa_priv.pem
+
+Every NAME=FILE yields a `const br_rsa_i15_pubctx NAME_pub` with the
+modulus decoded to 15-bit words, its Montgomery constant m0i and
+R^2 mod N, exactly as br_rsa_i15_pubctx_init() would compute them.
+Private keys also yield a `const br_rsa_i15_privctx NAME_priv` with
+the same values for both prime factors and the CRT coefficient iq in
+Montgomery representation modulo p.
+
+With --sign LEN[,LEN...], private keys also yield `const rsakey_sig
+NAME_sig[]`: a PKCS#1 v1.5 and an RSA-PSS signature (SHA-256, MGF1 with
+SHA-256, a fixed salt of PSS_SALT_LEN bytes) over the first LEN bytes of
+the pattern message (byte i is i & 0xFF), for benchmarking the whole
+verification path on the device without a signer there.
+
+Accepted encodings: SubjectPublicKeyInfo ("PUBLIC KEY"), PKCS#1
+RSAPublicKey ("RSA PUBLIC KEY"), PKCS#8 PrivateKeyInfo ("PRIVATE KEY")
+and PKCS#1 RSAPrivateKey ("RSA PRIVATE KEY"). Encrypted keys are not.
+"""
+
+import argparse
+import base64
+import hashlib
+import math
+import os
+import re
+import sys
+
+PEM_BLOCK = re.compile(r'-----BEGIN ([A-Z ]+)-----(.*?)-----END \1-----', re.S)
+# 1.2.840.113549.1.1.1
+RSA_ENCRYPTION = bytes.fromhex('2a864886f70d010101')
+
+TAG_INTEGER = 0x02
+TAG_BIT_STRING = 0x03
+TAG_OCTET_STRING = 0x04
+TAG_OID = 0x06
+TAG_SEQUENCE = 0x30
+
+# DigestInfo header of a SHA-256 hash (PKCS#1 v1.5, with the NULL)
+SHA256_DIGEST_INFO = bytes.fromhex('3031300d060960864801650304020105000420')
+# PSS salt length of the --sign signatures, the hash length as usual
+PSS_SALT_LEN = 32
+
+HEADER = '''/* Generated by tools/rsakey.py from {sources}.
+   Do not edit. */
+
+#pragma once
+
+#include "bearssl_rsa.h"
+
+/* Signatures over the first msg_len bytes of the pattern message,
+   whose byte i is i & 0xFF (rsakey.py --sign): PKCS#1 v1.5 with
+   SHA-256, and RSA-PSS with SHA-256 and MGF1-SHA-256 */
+typedef struct {{
+	uint32_t msg_len;
+	const unsigned char *sig;
+	size_t sig_len;
+	const unsigned char *pss;
+	size_t pss_len;
+	size_t salt_len;
+}} rsakey_sig;
+
+{decls}
+'''
+
+SOURCE = '''/* Generated by tools/rsakey.py from {sources}.
+   Do not edit. */
+
+#include "{header}"
+
+/* the tables below are sized by the largest key */
+#if BR_RSA_I15_PUBCTX_MAX_BITS < {bits}
+#error "BR_RSA_I15_PUBCTX_MAX_BITS is too small for the compiled keys"
+#endif
+{body}'''
+
+
+class KeyFormatError(Exception):
+    pass
+
+
+def der_next(buf, off):
+    """Return (tag, value start, value end) of the element at off."""
+    if off + 2 > len(buf):
+        raise KeyFormatError('truncated DER')
+    tag = buf[off]
+    n = buf[off + 1]
+    off += 2
+    if n & 0x80:
+        k = n & 0x7F
+        if k == 0 or k > 4 or off + k > len(buf):
+            raise KeyFormatError('bad DER length')
+        n = int.from_bytes(buf[off:off + k], 'big')
+        off += k
+    if off + n > len(buf):
+        raise KeyFormatError('truncated DER')
+    return tag, off, off + n
+
+
+def der_children(buf, start, end):
+    """Elements of a constructed value, as (tag, start, end)."""
+    items = []
+    while start < end:
+        tag, vs, ve = der_next(buf, start)
+        items.append((tag, vs, ve))
+        start = ve
+    return items
+
+
+def der_sequence(buf, start=0, end=None):
+    tag, vs, ve = der_next(buf, start)
+    if tag != TAG_SEQUENCE or (end is not None and ve != end):
+        raise KeyFormatError('expected a SEQUENCE')
+    return der_children(buf, vs, ve)
+
+
+def der_ints(buf, items):
+    if any(tag != TAG_INTEGER for tag, _, _ in items):
+        raise KeyFormatError('expected INTEGERs')
+    return [int.from_bytes(buf[s:e], 'big', signed=True) for _, s, e in items]
+
+
+def check_algorithm(buf, item):
+    tag, s, e = item
+    alg = der_children(buf, s, e) if tag == TAG_SEQUENCE else []
+    if not alg or alg[0][0] != TAG_OID or buf[alg[0][1]:alg[0][2]] != RSA_ENCRYPTION:
+        raise KeyFormatError('not an RSA key')
+
+
+def parse_der(buf):
+    """Return a dict with n, e and, for private keys, p, q, dp, dq, iq."""
+    top = der_sequence(buf)
+    if len(top) == 2 and top[0][0] == TAG_SEQUENCE:
+        # SubjectPublicKeyInfo
+        check_algorithm(buf, top[0])
+        tag, s, e = top[1]
+        if tag != TAG_BIT_STRING or buf[s] != 0:
+            raise KeyFormatError('bad public key BIT STRING')
+        return parse_der(buf[s + 1:e])
+    if len(top) == 2:
+        n, e = der_ints(buf, top)
+        return {'n': n, 'e': e}
+    if len(top) >= 3 and top[1][0] == TAG_SEQUENCE:
+        # PKCS#8 PrivateKeyInfo
+        check_algorithm(buf, top[1])
+        tag, s, e = top[2]
+        if tag != TAG_OCTET_STRING:
+            raise KeyFormatError('bad PrivateKeyInfo')
+        return parse_der(buf[s:e])
+    if len(top) >= 9:
+        ver, n, e, _, p, q, dp, dq, iq = der_ints(buf, top[:9])
+        if ver not in (0, 1):
+            raise KeyFormatError('unsupported RSAPrivateKey version %d' % ver)
+        return {'n': n, 'e': e, 'p': p, 'q': q, 'dp': dp, 'dq': dq, 'iq': iq}
+    raise KeyFormatError('unrecognised key structure')
+
+
+def load_key(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    m = PEM_BLOCK.search(data.decode('ascii', 'replace'))
+    if m:
+        if 'ENCRYPTED' in m.group(1):
+            raise KeyFormatError('encrypted keys are not supported')
+        data = base64.b64decode(''.join(m.group(2).split()))
+    key = parse_der(data)
+    if key['n'] <= 1 or key['n'] % 2 == 0:
+        raise KeyFormatError('modulus is not odd')
+    if 'p' in key and key['p'] * key['q'] != key['n']:
+        raise KeyFormatError('p * q != n')
+    return key
+
+
+# ---------------------------------------------------------------------
+# i15 representation (inner.h): word 0 is the encoded bit length,
+# (k << 4) + bits of word k for the top nonzero word k, then 15-bit
+# words, least significant first.
+
+def i15_bitlen(x):
+    if x == 0:
+        return 0
+    k = (x.bit_length() - 1) // 15
+    return (k << 4) + x.bit_length() - 15 * k
+
+
+def i15_words(x, announced):
+    """x in i15 form with the given header word."""
+    words = [announced]
+    for _ in range((announced + 15) >> 4):
+        words.append(x & 0x7FFF)
+        x >>= 15
+    return words
+
+
+def i15_modulus(m):
+    """(words, m0i, R^2 mod m words) as br_i15_decode/ninv15/to_monty give."""
+    hdr = i15_bitlen(m)
+    r = 1 << (15 * ((hdr + 15) >> 4))
+    m0i = (-pow(m, -1, 1 << 15)) & 0x7FFF
+    return i15_words(m, hdr), m0i, i15_words(r * r % m, hdr)
+
+
+def be_bytes(x):
+    return x.to_bytes(max(1, (x.bit_length() + 7) // 8), 'big')
+
+
+def c_bytes(data, indent='\t'):
+    lines = []
+    for i in range(0, len(data), 12):
+        lines.append(indent + ', '.join('0x%02X' % b for b in data[i:i + 12]) + ',')
+    return '\n'.join(lines)
+
+
+def c_words(words, indent='\t\t'):
+    lines = []
+    for i in range(0, len(words), 8):
+        lines.append(indent + ', '.join('0x%04X' % w for w in words[i:i + 8]) + ',')
+    return '\n'.join(lines)
+
+
+def c_array(name, data):
+    return 'static const unsigned char %s[] = {\n%s\n};\n' % (name, c_bytes(data))
+
+
+def emit_pub(name, key):
+    n_be = be_bytes(key['n'])
+    m, m0i, r2 = i15_modulus(key['n'])
+    return (c_array(name + '_e', be_bytes(key['e'])) + '''
+#if BR_I15_FIXED_BITS && (BR_I15_FIXED_BITS + 14) / 15 != {words}
+#error "{name}: the i15 kernels are built for another key size (BR_I15_FIXED_BITS)"
+#endif
+
+const br_rsa_i15_pubctx {name}_pub = {{
+	.m0i = 0x{m0i:04X},
+	.m = {{
+{m}
+	}},
+	.r2 = {{
+{r2}
+	}},
+	.nlen = {nlen},
+	.e = {name}_e,
+	.elen = sizeof {name}_e
+}};
+'''.format(name=name, m0i=m0i, m=c_words(m), r2=c_words(r2), nlen=len(n_be),
+           words=len(m) - 1))
+
+
+def emit_priv(name, key):
+    p, p0i, r2p = i15_modulus(key['p'])
+    q, q0i, r2q = i15_modulus(key['q'])
+    rp = 1 << (15 * ((p[0] + 15) >> 4))
+    iq = i15_words(key['iq'] * rp % key['p'], p[0])
+    return (c_array(name + '_dp', be_bytes(key['dp']))
+            + c_array(name + '_dq', be_bytes(key['dq'])) + '''
+const br_rsa_i15_privctx {name}_priv = {{
+	.n_bitlen = {bits},
+	.p0i = 0x{p0i:04X},
+	.p = {{
+{p}
+	}},
+	.r2p = {{
+{r2p}
+	}},
+	.iq = {{
+{iq}
+	}},
+	.q = {{
+{q}
+	}},
+	.r2q = {{
+{r2q}
+	}},
+	.q0i = 0x{q0i:04X},
+	.dp = {name}_dp,
+	.dplen = sizeof {name}_dp,
+	.dq = {name}_dq,
+	.dqlen = sizeof {name}_dq
+}};
+'''.format(name=name, bits=key['n'].bit_length(), p0i=p0i, q0i=q0i,
+           p=c_words(p), r2p=c_words(r2p), iq=c_words(iq),
+           q=c_words(q), r2q=c_words(r2q)))
+
+
+def pattern(n):
+    """The message --sign signs: byte i is i & 0xFF."""
+    return (bytes(range(256)) * (n // 256 + 1))[:n]
+
+
+def rsa_sign(key, em):
+    """em^d mod n, as many bytes as the modulus."""
+    n = key['n']
+    lam = (key['p'] - 1) * (key['q'] - 1) // math.gcd(key['p'] - 1, key['q'] - 1)
+    d = pow(key['e'], -1, lam)
+    return pow(int.from_bytes(em, 'big'), d, n).to_bytes((n.bit_length() + 7) // 8, 'big')
+
+
+def pkcs1_sign(key, msg):
+    k = (key['n'].bit_length() + 7) // 8
+    t = SHA256_DIGEST_INFO + hashlib.sha256(msg).digest()
+    if k < len(t) + 11:
+        raise KeyFormatError('modulus too short for a SHA-256 signature')
+    return rsa_sign(key, b'\x00\x01' + b'\xff' * (k - len(t) - 3) + b'\x00' + t)
+
+
+def mgf1(seed, length):
+    out = b''
+    for c in range((length + 31) // 32):
+        out += hashlib.sha256(seed + c.to_bytes(4, 'big')).digest()
+    return out[:length]
+
+
+def pss_sign(key, msg):
+    """EMSA-PSS (RFC 8017, 9.1.1) with SHA-256 and a fixed salt."""
+    em_bits = key['n'].bit_length() - 1
+    em_len = (em_bits + 7) // 8
+    if em_len < 32 + PSS_SALT_LEN + 2:
+        raise KeyFormatError('modulus too short for a PSS signature')
+    salt = hashlib.sha256(b'rsakey.py PSS salt').digest()[:PSS_SALT_LEN]
+    h = hashlib.sha256(bytes(8) + hashlib.sha256(msg).digest() + salt).digest()
+    db = bytes(em_len - PSS_SALT_LEN - 32 - 2) + b'\x01' + salt
+    masked = bytearray(a ^ b for a, b in zip(db, mgf1(h, len(db))))
+    masked[0] &= 0xFF >> (8 * em_len - em_bits)
+    return rsa_sign(key, bytes(masked) + h + b'\xbc')
+
+
+def emit_sigs(name, key, lengths):
+    out = ''
+    for n in lengths:
+        out += c_array('%s_sig_%d' % (name, n), pkcs1_sign(key, pattern(n)))
+        out += c_array('%s_pss_%d' % (name, n), pss_sign(key, pattern(n)))
+    return out + '\nconst rsakey_sig %s_sig[%d] = {\n%s\n};\n' % (
+        name, len(lengths), ',\n'.join(
+            '\t{ %d, %s_sig_%d, sizeof %s_sig_%d,\n'
+            '\t  %s_pss_%d, sizeof %s_pss_%d, %d }'
+            % (n, name, n, name, n, name, n, name, n, PSS_SALT_LEN)
+            for n in lengths))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('-o', '--output', required=True, help='output C source')
+    ap.add_argument('--header', required=True, help='output header')
+    ap.add_argument('--sign', default='', metavar='LEN[,LEN...]',
+                    help='sign the first LEN bytes of the pattern message'
+                         ' with every private key')
+    ap.add_argument('keys', nargs='+', metavar='NAME=FILE')
+    args = ap.parse_args()
+    try:
+        lengths = [int(n, 0) for n in args.sign.split(',') if n]
+    except ValueError:
+        sys.exit('rsakey: bad --sign list %r' % args.sign)
+
+    decls = []
+    body = []
+    sources = []
+    bits = 0
+    for spec in args.keys:
+        name, _, path = spec.partition('=')
+        if not re.match(r'^[A-Za-z_]\w*$', name) or not path:
+            sys.exit('rsakey: expected NAME=FILE, got %r' % spec)
+        try:
+            key = load_key(path)
+        except (KeyFormatError, ValueError) as e:
+            sys.exit('rsakey: %s: %s' % (path, e))
+        sources.append(path)
+        bits = max(bits, key['n'].bit_length())
+
+        decls.append('extern const br_rsa_i15_pubctx %s_pub;' % name)
+        body.append(emit_pub(name, key))
+        kind = 'public'
+        if 'p' in key:
+            decls.append('extern const br_rsa_i15_privctx %s_priv;' % name)
+            body.append(emit_priv(name, key))
+            kind = 'private'
+            if lengths:
+                decls.append('extern const rsakey_sig %s_sig[%d];'
+                             % (name, len(lengths)))
+                body.append(emit_sigs(name, key, lengths))
+        sys.stderr.write('rsakey: %s: %d-bit %s key -> %s\n'
+                         % (path, key['n'].bit_length(), kind, name))
+
+    with open(args.header, 'w') as f:
+        f.write(HEADER.format(sources=', '.join(sources), decls='\n'.join(decls)))
+    with open(args.output, 'w') as f:
+        f.write(SOURCE.format(sources=', '.join(sources), bits=bits,
+                              header=os.path.basename(args.header),
+                              body=''.join('\n' + b for b in body)))
+
+
+if __name__ == '__main__':
+    main()